@@ -3,6 +3,7 @@
 */
 #pragma once
 
+#include "reactions/composite_database.hpp"
 #include "reactions/database.hpp"
 #include "reactions/element_traits.hpp"
 #include "reactions/exceptions.hpp"
@@ -10,6 +11,7 @@
 #include "reactions/pdg.hpp"
 #include "reactions/pow_enum.hpp"
 #include "reactions/processes.hpp"
+#include "reactions/stats.hpp"
 #include "reactions/tokens.hpp"
 #include "reactions/utils.hpp"
 
@@ -0,0 +1,197 @@
+/*! \file
+  \brief Resolver serving elements from the PDG and NuBase databases at once
+*/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <variant>
+
+#include "reactions/element_traits.hpp"
+#include "reactions/nubase.hpp"
+#include "reactions/pdg.hpp"
+
+namespace reactions {
+
+  /// Element resolved from either the PDG or the NuBase database
+  using mixed_element = std::variant<pdg_element, nubase_element>;
+
+  /*! \brief Resolver over the PDG and NuBase databases
+   *
+   * The composite database maintains unified name and ID indices
+   * mapping each key to the database that owns it, so resolving an
+   * element of either kind costs one probe of the unified index plus
+   * one lookup in the owning database, instead of a failed lookup in
+   * one database followed by a lookup in the other. On a name or ID
+   * present in both databases (like "e-", "gamma" or the IDs 1 and 2)
+   * the PDG entry takes precedence. The caches of both databases can be
+   * warmed concurrently. The unified indices are built lazily on first
+   * use and are immutable once built: lookups work on a shared snapshot,
+   * so \ref composite_database::reset (needed if elements are
+   * registered in the underlying databases afterwards) can be called
+   * concurrently with lookups, which keep using the snapshot they
+   * started with.
+   */
+  class composite_database final {
+
+  public:
+    using element_type = mixed_element;
+
+    /// Get the only instance of this class
+    static composite_database &instance() {
+      static composite_database db;
+      return db;
+    }
+
+    /// Resolve an element by name through the unified index
+    mixed_element operator()(std::string const &name) const {
+
+      auto unified = ensure_indices();
+
+      auto it = unified->by_name.find(name);
+
+      if (it == unified->by_name.cend())
+        throw reactions::lookup_error(
+            (std::string{"Unable to find element with name \""} + name +
+             "\" in the PDG and NuBase databases")
+                .c_str());
+
+      if (it->second == source::pdg)
+        return pdg_database::instance()(name);
+
+      return nubase_database::instance()(name);
+    }
+
+    /// Resolve an element by ID through the unified index
+    mixed_element operator()(int id) const {
+
+      auto unified = ensure_indices();
+
+      auto it = unified->by_id.find(id);
+
+      if (it == unified->by_id.cend())
+        throw reactions::lookup_error(
+            (std::string{"Unable to find element with ID \""} +
+             std::to_string(id) + "\" in the PDG and NuBase databases")
+                .c_str());
+
+      if (it->second == source::pdg)
+        return pdg_database::instance()(id);
+
+      return nubase_database::instance()(id);
+    }
+
+    /*! \brief Warm the caches of both databases
+     *
+     * With the concurrent flag set, each cache is filled in its own
+     * thread. The unified indices are built afterwards.
+     */
+    void enable_cache(bool concurrent = false) {
+
+      if (concurrent) {
+
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto warm = [&error, &error_mutex](auto &db) -> void {
+          try {
+            db.enable_cache();
+          } catch (...) {
+            std::lock_guard<std::mutex> lock{error_mutex};
+            if (!error)
+              error = std::current_exception();
+          }
+        };
+
+        std::thread pdg{[&warm]() { warm(pdg_database::instance()); }};
+        std::thread nubase{[&warm]() { warm(nubase_database::instance()); }};
+
+        pdg.join();
+        nubase.join();
+
+        if (error)
+          std::rethrow_exception(error);
+
+      } else {
+        pdg_database::instance().enable_cache();
+        nubase_database::instance().enable_cache();
+      }
+
+      ensure_indices();
+    }
+
+    /// Drop the unified indices, which are rebuilt on the next lookup
+    void reset() {
+      std::lock_guard<std::mutex> lock{m_mutex};
+      m_indices.reset();
+    }
+
+  private:
+    /// Database owning an entry of the unified indices
+    enum class source : std::uint8_t { pdg, nubase };
+
+    /// Unified indices over the two databases
+    struct indices {
+      /// Owning database by element name
+      std::unordered_map<std::string, source> by_name;
+      /// Owning database by element ID
+      std::unordered_map<int, source> by_id;
+    };
+
+    /// Pointer to an immutable set of indices
+    using indices_ptr = std::shared_ptr<indices const>;
+
+    /// Unified indices, built on first use; once published they are
+    /// immutable, so readers keep their snapshot alive across a reset
+    mutable indices_ptr m_indices;
+
+    /// Serialize the construction and replacement of the indices
+    mutable std::mutex m_mutex;
+
+    /// Get a snapshot of the unified indices, building them if needed
+    indices_ptr ensure_indices() const {
+
+      std::lock_guard<std::mutex> lock{m_mutex};
+
+      if (m_indices)
+        return m_indices;
+
+      auto result = std::make_shared<indices>();
+
+      for (auto const &el : pdg_database::instance().all_elements()) {
+        result->by_name.emplace(el.name(), source::pdg);
+        result->by_id.emplace(el.pdg_id(), source::pdg);
+      }
+
+      for (auto const &el : nubase_database::instance().all_elements()) {
+        result->by_name.emplace(el.name(), source::nubase);
+        result->by_id.emplace(el.nubase_id(), source::nubase);
+      }
+
+      m_indices = std::move(result);
+
+      return m_indices;
+    }
+
+    composite_database() = default;
+    composite_database(composite_database &&) = delete;
+    composite_database(composite_database const &) = delete;
+    void operator=(composite_database &&) = delete;
+    void operator=(composite_database const &) = delete;
+  };
+} // namespace reactions
+
+namespace reactions::element_traits {
+
+  /// Definition of the properties of a mixed PDG/NuBase element
+  template <> struct properties<reactions::mixed_element> {
+    using type = reactions::mixed_element;
+    static constexpr auto builder = [](std::string const &s) {
+      return reactions::composite_database::instance()(s);
+    };
+  };
+} // namespace reactions::element_traits
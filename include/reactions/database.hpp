@@ -2,18 +2,160 @@
   \brief Define the base database class
  */
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
 #include <fstream>
 #include <ios>
 #include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 #include "reactions/exceptions.hpp"
 #include "reactions/fields.hpp"
+#include "reactions/stats.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define REACTIONS_DATABASE_WITH_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <iterator>
+#endif
 
 /// Common tools and base objects to handle databases
 namespace reactions::database {
 
+  /// Internal utilities for the \ref reactions::database namespace
+  namespace detail {
+
+    /// Marker identifying a compiled database table
+    static constexpr char compiled_table_magic[8] = {'R', 'E', 'A', 'C',
+                                                     'T', 'B', 'I', 'N'};
+
+    /// Version of the compiled-table format
+    static constexpr std::uint32_t compiled_table_version = 1;
+
+    /// Value used to detect endianness mismatches
+    static constexpr std::uint32_t compiled_table_endianness = 0x01020304u;
+
+    /// Marker identifying a sidecar index of a database table
+    static constexpr char sidecar_index_magic[8] = {'R', 'E', 'A', 'C',
+                                                    'T', 'I', 'D', 'X'};
+
+    /// Version of the sidecar-index format
+    static constexpr std::uint32_t sidecar_index_version = 2;
+
+    /*! \brief Read-only view of a whole database file
+     *
+     * On POSIX systems the file is memory-mapped, so accessing its
+     * contents involves no buffered reads and no per-line allocations.
+     * On other systems the file is read at once into an internal buffer,
+     * keeping the same interface.
+     */
+    class mapped_file final {
+
+    public:
+      /// Build an empty mapping
+      mapped_file() = default;
+
+      /// Map the file with the given path
+      explicit mapped_file(std::string const &path) {
+
+#ifdef REACTIONS_DATABASE_WITH_MMAP
+        auto fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd < 0)
+          throw reactions::database_error("Unable to access the database");
+
+        struct stat sb;
+        if (::fstat(fd, &sb) < 0) {
+          ::close(fd);
+          throw reactions::database_error("Unable to access the database");
+        }
+
+        m_size = static_cast<std::size_t>(sb.st_size);
+
+        if (m_size != 0) {
+          m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (m_data == MAP_FAILED) {
+            ::close(fd);
+            throw reactions::database_error("Unable to map the database file");
+          }
+        }
+
+        ::close(fd);
+#else
+        std::ifstream file{path, std::ios::binary};
+
+        if (!file.is_open())
+          throw reactions::database_error("Unable to access the database");
+
+        m_buffer.assign(std::istreambuf_iterator<char>(file),
+                        std::istreambuf_iterator<char>());
+#endif
+      }
+
+      /// Release the mapped region
+      ~mapped_file() {
+#ifdef REACTIONS_DATABASE_WITH_MMAP
+        if (m_data)
+          ::munmap(m_data, m_size);
+#endif
+      }
+
+      mapped_file(mapped_file &&other) noexcept { *this = std::move(other); }
+
+      mapped_file &operator=(mapped_file &&other) noexcept {
+#ifdef REACTIONS_DATABASE_WITH_MMAP
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+#else
+        std::swap(m_buffer, other.m_buffer);
+#endif
+        return *this;
+      }
+
+      mapped_file(mapped_file const &) = delete;
+      void operator=(mapped_file const &) = delete;
+
+      /// View of the whole file contents
+      std::string_view view() const {
+#ifdef REACTIONS_DATABASE_WITH_MMAP
+        return m_data ? std::string_view{static_cast<char const *>(m_data),
+                                         m_size}
+                      : std::string_view{};
+#else
+        return m_buffer;
+#endif
+      }
+
+    private:
+#ifdef REACTIONS_DATABASE_WITH_MMAP
+      /// Pointer to the mapped region
+      void *m_data = nullptr;
+      /// Size of the mapped region
+      std::size_t m_size = 0;
+#else
+      /// Buffer with the file contents
+      std::string m_buffer;
+#endif
+    };
+  } // namespace detail
+
   /*! \brief Base database class
    *
    */
@@ -37,46 +179,143 @@ namespace reactions::database {
 
       std::vector<element_type> out;
 
-      switch (m_cache.status()) {
+      auto snap = m_cache.snapshot();
+
+      switch (snap->status()) {
 
       case (cache::full):
 
-        out.insert(out.end(), m_cache.begin(), m_cache.end());
+        out.insert(out.end(), snap->begin(), snap->end());
         return out;
 
       default:
 
-        // open the database to count the number of lines
-        auto file = open_database();
+        if (has_embedded_table() || m_use_mmap) {
 
-        auto start = skip_commented_lines(file);
+          // the mapping stays empty when reading from the embedded table
+          auto mapping = has_embedded_table() ? detail::mapped_file{}
+                                              : map_database();
 
-        std::size_t count = 0;
-        while (file.ignore(element_type::line_size + 1)) // include end-of-line
-          ++count;
+          auto data = skip_commented_lines(
+              has_embedded_table() ? m_embedded : mapping.view());
 
-        file.clear(); // we reached the end of the file
+          out.reserve(count_elements(data) + snap->size());
 
-        // go back to the start of the table and read the elements
-        file.seekg(start);
+          while (!data.empty())
+            out.emplace_back(read_element(next_line(data)));
 
-        out.reserve(count + m_cache.size());
+        } else {
 
-        for (auto i = 0u; i < count; ++i) {
-          std::string line;
-          std::getline(file, line);
-          out.emplace_back(read_element(line));
-        }
+          // open the database to count the number of lines
+          auto file = open_database();
 
-        if (m_cache.size())
-          out.insert(out.end(), m_cache.begin(), m_cache.end());
+          skip_commented_lines(file);
 
-        file.close();
+          auto count = count_elements(file);
+
+          out.reserve(count + snap->size());
+
+          for (auto i = 0u; i < count; ++i) {
+            std::string line;
+            std::getline(file, line);
+            out.emplace_back(read_element(line));
+          }
+
+          file.close();
+        }
+
+        if (snap->size())
+          out.insert(out.end(), snap->begin(), snap->end());
       }
 
       return out;
     }
 
+    /*! \brief View of the cached elements, without copying them
+     *
+     * Unlike \ref database::all_elements, no copy of the elements is
+     * made: the returned object points to the immutable storage of the
+     * cache, which can be traversed through its *begin* and *end*
+     * member functions (or the *database_cbegin*, *database_cend*,
+     * *user_registered_cbegin* and *user_registered_cend* ones to
+     * traverse only one of the two segments). The view remains valid
+     * (and unchanged) for as long as it is kept alive, even if the
+     * cache is modified or disabled afterwards. The cache must be
+     * enabled when calling this function.
+     */
+    auto all_elements_view() const {
+
+      auto snap = m_cache.snapshot();
+
+      if (snap->status() != cache::full)
+        throw reactions::database_error(
+            "A view of the elements requires the cache to be enabled");
+
+      return snap;
+    }
+
+    /*! \brief Contiguous column with the values of a field of the cache
+     *
+     * The values of the given field (and optional subfield) of all the
+     * cached elements are exposed as one contiguous vector in cache
+     * order, so scans over a single field stream through memory instead
+     * of striding over whole elements. Missing optional values are
+     * stored as NaN for floating-point fields and as default-built
+     * values otherwise, and fields with units are scaled according to
+     * the system of units at the time the column is built. Columns are
+     * built once per cache state and shared afterwards: any change to
+     * the cache (enabling, disabling or registering elements) triggers
+     * a rebuild on the next request, while columns already handed out
+     * remain valid and unchanged. The cache must be enabled.
+     */
+    template <class Field, class... Subfield> auto column() const {
+
+      using value_type =
+          std::decay_t<decltype(std::declval<element_type const &>()
+                                    .template get<Field, Subfield...>())>;
+
+      auto snap = m_cache.snapshot();
+
+      if (snap->status() != cache::full)
+        throw reactions::database_error(
+            "Field columns require the cache to be enabled");
+
+      std::lock_guard<std::mutex> lock{m_column_mutex};
+
+      // drop the columns of any previous cache state
+      if (m_column_snapshot != snap) {
+        m_columns.clear();
+        m_column_snapshot = snap;
+      }
+
+      auto key = std::type_index(typeid(std::tuple<Field, Subfield...>));
+
+      auto it = m_columns.find(key);
+
+      if (it == m_columns.cend()) {
+
+        auto col = std::make_shared<std::vector<value_type>>();
+        col->reserve(snap->size());
+
+        for (auto const &el : *snap) {
+          if (el.template has<Field>())
+            col->emplace_back(el.template get<Field, Subfield...>());
+          else if constexpr (std::is_floating_point_v<value_type>)
+            col->emplace_back(std::numeric_limits<value_type>::quiet_NaN());
+          else
+            col->emplace_back(value_type{});
+        }
+
+        it = m_columns
+                 .emplace(key,
+                          std::shared_ptr<void const>{std::move(col)})
+                 .first;
+      }
+
+      return std::static_pointer_cast<std::vector<value_type> const>(
+          it->second);
+    }
+
     /// Clear the cache, removing also user-registered elements
     void clear_cache() { m_cache.clear(); }
 
@@ -94,28 +333,116 @@ namespace reactions::database {
       if (m_cache.status() == cache::full)
         return;
 
-      // open the database to count the number of lines
-      auto file = open_database();
+      if (!has_embedded_table() && points_to_compiled_table()) {
 
-      auto start = skip_commented_lines(file);
+        auto mapping = map_database();
 
-      std::size_t count = 0;
-      while (file.ignore(element_type::line_size + 1)) // include end-of-line
-        ++count;
+        load_compiled(mapping.view());
 
-      file.clear(); // we reached the end of the file
+        return;
+      }
 
-      // go back to the start of the table and read the elements
-      file.seekg(start);
+      if (has_embedded_table() || m_use_mmap) {
+
+        // the mapping stays empty when reading from the embedded table
+        auto mapping =
+            has_embedded_table() ? detail::mapped_file{} : map_database();
+
+        auto data = skip_commented_lines(has_embedded_table() ? m_embedded
+                                                              : mapping.view());
+
+        m_cache.add_database_elements(count_elements(data),
+                                      [this, &data]() -> element_type {
+                                        return read_element(next_line(data));
+                                      });
+
+      } else {
+
+        // open the database to count the number of lines
+        auto file = open_database();
+
+        skip_commented_lines(file);
+
+        auto count = count_elements(file);
+
+        std::string line;
+        m_cache.add_database_elements(count,
+                                      [this, &file, &line]() -> element_type {
+                                        std::getline(file, line);
+                                        return read_element(line);
+                                      });
+
+        file.close();
+      }
+    }
+
+    /*! \brief Enable the internal cache reading the database in parallel
+     *
+     * The database contents are brought to memory at once, split into
+     * lines and parsed concurrently across the given number of threads.
+     * With a concurrency of one this is equivalent to \ref
+     * database::enable_cache.
+     */
+    void enable_cache(unsigned concurrency) {
+
+      if (concurrency <= 1)
+        return enable_cache();
+
+      if (m_cache.status() == cache::full)
+        return;
+
+      if (!has_embedded_table() && points_to_compiled_table())
+        return enable_cache(); // deserializing needs no parallelism
+
+      // whatever the read mode, the whole table is brought to memory
+      auto mapping =
+          has_embedded_table() ? detail::mapped_file{} : map_database();
+
+      auto data = skip_commented_lines(has_embedded_table() ? m_embedded
+                                                            : mapping.view());
+
+      std::vector<std::string_view> lines;
+      lines.reserve(count_elements(data));
+
+      while (!data.empty())
+        lines.emplace_back(next_line(data));
+
+      std::vector<std::optional<element_type>> slots(lines.size());
+
+      std::atomic<std::size_t> cursor{0};
+      std::exception_ptr error;
+      std::mutex error_mutex;
+
+      std::vector<std::thread> workers;
+      workers.reserve(concurrency);
+      for (auto t = 0u; t < concurrency; ++t)
+        workers.emplace_back([this, &lines, &slots, &cursor, &error,
+                              &error_mutex]() -> void {
+          std::size_t i;
+          while ((i = cursor.fetch_add(1)) < lines.size()) {
+            try {
+              slots[i].emplace(read_element(lines[i]));
+            } catch (...) {
+              std::lock_guard<std::mutex> lock{error_mutex};
+              if (!error)
+                error = std::current_exception();
+            }
+          }
+        });
+
+      for (auto &worker : workers)
+        worker.join();
 
-      std::string line;
-      m_cache.add_database_elements(count,
-                                    [this, &file, &line]() -> element_type {
-                                      std::getline(file, line);
-                                      return read_element(line);
-                                    });
+      if (error)
+        std::rethrow_exception(error);
 
-      file.close();
+      typename cache::cache_type elements;
+      elements.reserve(slots.size());
+
+      for (auto &slot : slots)
+        elements.emplace_back(std::move(*slot));
+
+      m_cache.add_database_elements(std::move(elements));
     }
 
     /// Get the path to the database file
@@ -132,39 +459,22 @@ namespace reactions::database {
       element_type new_element{std::forward<Args>(args)...};
 
       // If the cache is enabled, the checks are done within the cache object,
-      // otherwise we must check the database
+      // otherwise the scan index of the database file is probed
       if (m_cache.status() != cache::full) {
 
-        auto file = open_database();
-
-        skip_commented_lines(file);
-
-        std::string line;
-
-        while (std::getline(file, line)) {
+        auto const &index = ensure_scan_index();
 
-          typename NameField::value_type name;
-          if (reactions::fields::read_field<typename NameField::range_type>(
-                  name, line) == reactions::fields::failed)
-            throw reactions::database_error(
-                "Error reading the database; data format not understood");
-
-          if (new_element.template get<NameField>() == name)
-            throw reactions::database_error(
-                "Attempt to register an element with similar name to an "
-                "element in the database");
-
-          typename IdField::value_type id;
-          if (reactions::fields::read_field<typename IdField::range_type>(
-                  id, line) == reactions::fields::failed)
-            throw reactions::database_error(
-                "Error reading the database; data format not understood");
+        if (index.by_name.find(new_element.template get<NameField>()) !=
+            index.by_name.cend())
+          throw reactions::database_error(
+              "Attempt to register an element with similar name to an "
+              "element in the database");
 
-          if (new_element.template get<IdField>() == id)
-            throw reactions::database_error(
-                "Attempt to register an element with similar ID to an "
-                "element in the database");
-        }
+        if (index.by_id.find(new_element.template get<IdField>()) !=
+            index.by_id.cend())
+          throw reactions::database_error(
+              "Attempt to register an element with similar ID to an "
+              "element in the database");
       }
 
       // this must be done after the checks are done to prevent leaving
@@ -175,26 +485,206 @@ namespace reactions::database {
     /* \brief Set the path to the database file.
      *
      * If the cache is enabled, reloads the content using the new path.
+     * If the new path points to a compiled table (see \ref
+     * database::compile_to), the cache is enabled directly from it.
      */
     void set_database_path(std::string const &s) {
       m_db = s;
+      reset_scan_index();
+      clear_lru();
+      if (m_cache.status() == cache::full) {
+        disable_cache();
+        enable_cache();
+      } else if (points_to_compiled_table())
+        enable_cache();
+    }
+
+    /*! \brief Dump the database into a compiled table
+     *
+     * The elements of the database file (excluding any user-registered
+     * element) are parsed and written to the given path in a compact
+     * binary format with a versioned header, which also records the
+     * endianness of the writer. Loading a compiled table (by pointing
+     * the database path to it) fills the cache through raw reads of the
+     * records, with no text-field conversion.
+     */
+    void compile_to(std::string const &path) const {
+
+      std::ofstream out{path, std::ios::binary};
+
+      if (!out.is_open())
+        throw reactions::database_error("Unable to write the compiled table");
+
+      out.write(detail::compiled_table_magic,
+                sizeof(detail::compiled_table_magic));
+
+      write_binary(out, detail::compiled_table_version);
+      write_binary(out, detail::compiled_table_endianness);
+
+      // the number of elements is patched once all have been dumped
+      auto count_pos = out.tellp();
+      std::uint64_t count = 0;
+      write_binary(out, count);
+
+      for_each_line([this, &out, &count](std::string_view line) -> bool {
+        write_element(out, read_element(line));
+        ++count;
+        return false;
+      });
+
+      out.seekp(count_pos);
+      write_binary(out, count);
+    }
+
+    /*! \brief Read the database through a memory-mapped view of the file
+     *
+     * On POSIX systems the database file is mapped into memory whenever
+     * it must be scanned, and the elements are parsed directly from the
+     * mapped region, avoiding the buffered line-by-line reads and the
+     * per-line allocations of the default mode. On other systems the
+     * file is read at once into a single buffer instead.
+     */
+    void enable_memory_mapping() { m_use_mmap = true; }
+
+    /// Read the database through buffered reads of the file (default)
+    void disable_memory_mapping() { m_use_mmap = false; }
+
+    /// Whether the database file is read through a memory-mapped view
+    bool uses_memory_mapping() const { return m_use_mmap; }
+
+    /*! \brief Keep a bounded cache of the most recently resolved elements
+     *
+     * Unlike \ref database::enable_cache, which loads the whole table,
+     * this mode only retains the given number of most recently resolved
+     * elements, indexed by name and ID, so workflows touching a small
+     * working set of a large database hit memory on repeated lookups
+     * while the footprint stays capped. The partial cache only serves
+     * accesses by name or ID when the full cache is not enabled, and is
+     * dropped when the source of the database changes. A capacity of
+     * zero disables it.
+     */
+    void enable_lru_cache(std::size_t capacity) {
+
+      std::lock_guard<std::mutex> lock{m_lru_mutex};
+
+      m_lru_capacity = capacity;
+
+      while (m_lru.size() > m_lru_capacity)
+        lru_evict();
+    }
+
+    /// Drop the bounded cache of recently resolved elements
+    void disable_lru_cache() { enable_lru_cache(0); }
+
+    /*! \brief Serve the database from an in-memory table
+     *
+     * The given view must point to data with the same layout as the
+     * database file, and must remain valid for the lifetime of the
+     * database (like a table embedded in a header at compilation time).
+     * While set, no access to the filesystem is done; the database path
+     * is ignored. If the cache is enabled, its contents are reloaded
+     * from the new table.
+     */
+    void set_embedded_table(std::string_view data) {
+      m_embedded = data;
+      reset_scan_index();
+      clear_lru();
       if (m_cache.status() == cache::full) {
         disable_cache();
         enable_cache();
       }
     }
 
+    /// Stop serving the database from an in-memory table
+    void clear_embedded_table() { set_embedded_table(std::string_view{}); }
+
+    /// Whether the database is served from an in-memory table
+    bool has_embedded_table() const { return !m_embedded.empty(); }
+
+    /*! \brief Return a pointer to an interned copy of the element with the
+     * given name
+     *
+     * The first request for a given name resolves the element and
+     * stores it in an internal pool; subsequent requests return the
+     * same pointer, which remains valid for the lifetime of the
+     * database. This allows to share a single copy of each element
+     * among many consumers (like large collections of parsed
+     * processes) instead of storing one copy per use. The pool is not
+     * affected by changes to the cache or the database path, so the
+     * interned elements reflect the database as it was when they were
+     * first requested. This function can be called concurrently from
+     * several threads.
+     */
+    element_type const *intern(typename NameField::value_type const &name) {
+
+      std::lock_guard<std::mutex> lock{m_intern_mutex};
+
+      auto it = m_intern_index.find(name);
+
+      if (it != m_intern_index.cend())
+        return it->second;
+
+      auto const &el = m_intern_pool.emplace_back(access<NameField>(name));
+
+      m_intern_index.emplace(name, &el);
+
+      return &el;
+    }
+
     /// Create an element accessing by ID
     virtual element_type operator()(int id) const = 0;
 
     /// Create an element accessing by name
     virtual element_type operator()(std::string const &str) const = 0;
 
+    /*! \brief Resolve a batch of elements by ID in a single call
+     *
+     * The whole batch is resolved in one traversal of the cache or, if
+     * the cache is not enabled, in a single scan of the database file,
+     * amortizing the access cost over all the queries. The elements are
+     * returned in the same order as the input values. A \ref
+     * reactions::lookup_error is thrown if any of the elements is not
+     * found.
+     */
+    std::vector<element_type>
+    bulk(std::vector<typename IdField::value_type> const &ids) const {
+      return bulk_impl<IdField>(ids);
+    }
+
+    /// \copydoc database::bulk
+    std::vector<element_type>
+    bulk(std::vector<typename NameField::value_type> const &names) const {
+      return bulk_impl<NameField>(names);
+    }
+
   protected:
     /// Path to the database file
     std::string m_db;
 
-    /// \brief Cache of elements
+    /// Whether database scans go through a memory-mapped view of the file
+    bool m_use_mmap = false;
+
+    /// Pool of interned elements, with stable addresses
+    std::deque<element_type> m_intern_pool;
+
+    /// Index of the interned elements by name
+    std::unordered_map<typename NameField::value_type, element_type const *>
+        m_intern_index;
+
+    /// Serialize the access to the intern pool
+    std::mutex m_intern_mutex;
+
+    /// In-memory table serving the database, if set
+    std::string_view m_embedded;
+
+    /*! \brief Cache of elements
+     *
+     * The contents are kept in an immutable storage object handled
+     * through a shared pointer that is read and replaced atomically.
+     * Readers work on a snapshot of the cache and need no
+     * synchronization; writers serialize among themselves, build a new
+     * storage object and swap it in.
+     */
     class cache {
 
     public:
@@ -205,90 +695,196 @@ namespace reactions::database {
       using const_iterator_type = typename cache_type::const_iterator;
       using size_type = typename cache_type::size_type;
 
-      cache() = default;
+      /// Immutable contents of the cache
+      class storage {
+
+      public:
+        storage() = default;
+
+        /// Status of the cache
+        cache_status status() const {
+          if (m_vector.size()) {
+            if (database_size() == 0)
+              return cache_status::user;
+            else
+              return cache_status::full;
+          } else
+            return cache_status::empty;
+        }
 
-      /// Clear the cache
-      void clear() {
-        m_vector.clear();
-        m_vector.shrink_to_fit();
-        m_separator = 0;
-      }
+        /// Underlying vector of elements
+        cache_type const &elements() const { return m_vector; }
 
-      /// Clear the cache
-      void clear_database_elements() {
-        m_vector.erase(database_cbegin(), database_cend());
-        m_vector.shrink_to_fit();
-        m_separator = 0;
-      }
+        /// Begining of the cache
+        const_iterator_type begin() const { return m_vector.cbegin(); }
 
-      /// Status of the cache
-      cache_status status() const {
-        if (m_vector.size()) {
-          if (database_size() == 0)
-            return cache_status::user;
-          else
-            return cache_status::full;
-        } else
-          return cache_status::empty;
-      }
+        /// End of the cache
+        const_iterator_type end() const { return m_vector.cend(); }
 
-      /// Underlying vector of elements
-      cache_type const &elements() const { return m_vector; }
+        /// Begining of the database elements
+        const_iterator_type database_cbegin() const {
+          return m_vector.cbegin();
+        }
 
-      /// Underlying vector of elements
-      cache_type &elements() { return m_vector; }
+        /// End of the database elements
+        const_iterator_type database_cend() const {
+          return m_vector.cbegin() + m_separator;
+        }
 
-      /// Begining of the cache
-      const_iterator_type begin() const { return m_vector.cbegin(); }
+        /// Begining of the user-registered elements
+        const_iterator_type user_registered_cbegin() const {
+          return database_cend();
+        }
 
-      /// End of the cache
-      const_iterator_type end() const { return m_vector.cend(); }
+        /// End of the user-registered elements
+        const_iterator_type user_registered_cend() const {
+          return m_vector.cend();
+        }
 
-      /// Begining of the database elements
-      const_iterator_type database_cbegin() const { return m_vector.cbegin(); }
+        /// Number of elements associated to the database
+        size_type database_size() const { return m_separator; }
 
-      /// End of the database elements
-      const_iterator_type database_cend() const {
-        return m_vector.cbegin() + m_separator;
-      }
+        /// Number of user-registered elements
+        size_type user_registered_size() const {
+          return m_vector.size() - m_separator;
+        }
 
-      /// Begining of the user-registered elements
-      const_iterator_type user_registered_cbegin() const {
-        return database_cend();
-      }
+        /// Number of cached elements
+        size_type size() const { return m_vector.size(); }
+
+        /*! \brief Find an element by the value of the given field
+         *
+         * Accesses by the name and ID fields are resolved through hash
+         * indices, making them constant on average. Any other field falls
+         * back to a linear scan over the cached elements.
+         *
+         * \return a pointer to the cached element, or a null pointer if
+         * no element matches the given value.
+         */
+        template <class Field, class T>
+        element_type const *find(T const &v) const {
+
+          if constexpr (std::is_same_v<Field, NameField>) {
+            auto it = m_name_index.find(v);
+            return it == m_name_index.cend() ? nullptr : &m_vector[it->second];
+          } else if constexpr (std::is_same_v<Field, IdField>) {
+            auto it = m_id_index.find(v);
+            return it == m_id_index.cend() ? nullptr : &m_vector[it->second];
+          } else {
+            auto e = end();
+            auto it = std::find_if(begin(), e, [&v](element_type const &el) {
+              return el.template get<Field>() == v;
+            });
+            return it == e ? nullptr : &(*it);
+          }
+        }
 
-      /// End of the user-registered elements
-      const_iterator_type user_registered_cend() const {
-        return m_vector.cend();
-      }
+      protected:
+        friend class cache;
 
-      /// Number of elements associated to the database
-      size_type database_size() const { return m_separator; }
+        /// Collection of elements
+        cache_type m_vector;
 
-      /// Number of user-registered elements
-      size_type user_registered_size() const {
-        return m_vector.size() - m_separator;
-      }
+        /// Hash index mapping names to positions in the cache
+        std::unordered_map<typename NameField::value_type, size_type>
+            m_name_index;
+
+        /// Hash index mapping IDs to positions in the cache
+        std::unordered_map<typename IdField::value_type, size_type> m_id_index;
+
+        /// Index that defines elements registered by the user and those read
+        /// from the database
+        size_type m_separator = 0;
+
+        /// Add the element at the given position to the hash indices
+        void index_element(size_type i) {
+          m_name_index.emplace(m_vector[i].template get<NameField>(), i);
+          m_id_index.emplace(m_vector[i].template get<IdField>(), i);
+        }
+
+        /// Rebuild the hash indices from the vector of elements
+        void rebuild_indices() {
+          m_name_index.clear();
+          m_id_index.clear();
+          m_name_index.reserve(m_vector.size());
+          m_id_index.reserve(m_vector.size());
+          for (size_type i = 0; i < m_vector.size(); ++i)
+            index_element(i);
+        }
+      };
+
+      /// Pointer to an immutable storage object
+      using storage_ptr = std::shared_ptr<storage const>;
+
+      cache() : m_data{std::make_shared<storage>()} {}
+
+      /*! \brief Get a snapshot of the current contents of the cache
+       *
+       * The snapshot is obtained atomically and stays valid (and
+       * unchanged) however the cache is modified afterwards, so readers
+       * in several threads need no synchronization with writers.
+       */
+      storage_ptr snapshot() const { return std::atomic_load(&m_data); }
+
+      /// Status of the cache
+      cache_status status() const { return snapshot()->status(); }
 
       /// Number of cached elements
-      size_type size() const { return m_vector.size(); }
+      size_type size() const { return snapshot()->size(); }
+
+      /// Clear the cache
+      void clear() {
+        std::lock_guard<std::mutex> lock{m_write_mutex};
+        publish(std::make_shared<storage>());
+      }
+
+      /// Clear the cache
+      void clear_database_elements() {
+
+        std::lock_guard<std::mutex> lock{m_write_mutex};
+
+        auto current = snapshot();
+
+        auto next = std::make_shared<storage>();
+        next->m_vector.assign(current->user_registered_cbegin(),
+                              current->user_registered_cend());
+        next->rebuild_indices();
+
+        publish(std::move(next));
+      }
 
       /// Add elements from a database by calling the given function several
       /// times
       template <class ElementReader>
       void add_database_elements(size_type n, ElementReader func) {
 
-        cache_type new_cache;
-        new_cache.reserve(n + user_registered_size());
+        cache_type elements;
+        elements.reserve(n);
+
+        for (auto i = 0u; i < n; ++i)
+          elements.emplace_back(func());
+
+        add_database_elements(std::move(elements));
+      }
+
+      /// Add already-read elements from a database
+      void add_database_elements(cache_type &&elements) {
 
-        for (auto i = 0u; i < n; ++i) {
+        std::lock_guard<std::mutex> lock{m_write_mutex};
 
-          auto new_element = func();
+        auto current = snapshot();
 
-          // check that we do not repeat any entry
-          if (user_registered_size() != 0) {
-            auto cend = user_registered_cend();
-            if (std::find_if(user_registered_cbegin(), cend,
+        auto n = elements.size();
+
+        auto next = std::make_shared<storage>();
+        next->m_vector = std::move(elements);
+        next->m_vector.reserve(n + current->user_registered_size());
+
+        // check that we do not repeat any entry
+        if (current->user_registered_size() != 0) {
+          for (auto const &new_element : next->m_vector) {
+            auto cend = current->user_registered_cend();
+            if (std::find_if(current->user_registered_cbegin(), cend,
                              [&new_element](element_type const &el) {
                                return (
                                    el.template get<NameField>() ==
@@ -299,50 +895,59 @@ namespace reactions::database {
               throw reactions::database_error(
                   (std::string{"User-defined element clashes with database "
                                "element: \""} +
-                   new_cache.back().name() + "\"")
+                   new_element.name() + "\"")
                       .c_str());
           }
-
-          new_cache.emplace_back(std::move(new_element));
         }
 
-        // insert the elements and assign the separator to the number of
-        // database elements
-        new_cache.insert(new_cache.end(),
-                         std::make_move_iterator(user_registered_cbegin()),
-                         std::make_move_iterator(user_registered_cend()));
-        m_separator = n;
-        m_vector = std::move(new_cache);
+        // insert the user-registered elements and assign the separator to
+        // the number of database elements
+        next->m_vector.insert(next->m_vector.end(),
+                              current->user_registered_cbegin(),
+                              current->user_registered_cend());
+        next->m_separator = n;
+        next->rebuild_indices();
+
+        publish(std::move(next));
       }
 
       /// Add a new element (by the user)
-      template <class... Args>
-      element_type const &add_user_element(Args &&...args) {
+      template <class... Args> void add_user_element(Args &&...args) {
+
         element_type new_element{std::forward<Args>(args)...};
-        auto e = end();
-        if (std::find_if(begin(), e,
-                         [this, &new_element](element_type const &el) {
-                           return (el.template get<NameField>() ==
-                                       new_element.template get<NameField>() ||
-                                   el.template get<IdField>() ==
-                                       new_element.template get<IdField>());
-                         }) != e) {
+
+        std::lock_guard<std::mutex> lock{m_write_mutex};
+
+        auto current = snapshot();
+
+        if (current->m_name_index.find(new_element.template get<NameField>()) !=
+                current->m_name_index.cend() ||
+            current->m_id_index.find(new_element.template get<IdField>()) !=
+                current->m_id_index.cend()) {
           throw reactions::database_error(
               (std::string{"User-registered element clashes: \""} +
                new_element.name() + "\"")
                   .c_str());
         }
-        m_vector.emplace_back(std::move(new_element));
-        return m_vector.back();
+
+        auto next = std::make_shared<storage>(*current);
+        next->m_vector.emplace_back(std::move(new_element));
+        next->index_element(next->m_vector.size() - 1);
+
+        publish(std::move(next));
       }
 
     protected:
-      /// Collection of elements
-      cache_type m_vector;
+      /// Current contents of the cache
+      storage_ptr m_data;
+
+      /// Serialize writers; readers do not use it
+      std::mutex m_write_mutex;
 
-      /// Index that defines elements registered by the user and those read from
-      /// the database
-      size_type m_separator = 0;
+      /// Atomically expose a new storage object to the readers
+      void publish(storage_ptr next) {
+        std::atomic_store(&m_data, std::move(next));
+      }
 
     } m_cache; /// Cache for elements loaded from the database or registered by
                /// the user
@@ -353,6 +958,8 @@ namespace reactions::database {
       if (m_db.empty())
         throw reactions::database_error("The database has not been specified");
 
+      stats::count_file_fallback();
+
       std::ifstream file;
 
       try {
@@ -367,13 +974,35 @@ namespace reactions::database {
       return file;
     }
 
-    /// Skip lines with comments (preceeded by *)
-    std::streampos skip_commented_lines(std::ifstream &file) const {
+    /*! \brief Count the number of elements from the current position
+     *
+     * The position of the file is left untouched. The count must check
+     * the number of characters actually discarded, since a final call
+     * reaching the end of the file without consuming any character
+     * would otherwise be included in the count.
+     */
+    std::size_t count_elements(std::ifstream &file) const {
 
-      char c;
-      while (true) {
-        file.get(c);
-        if (c == '*')
+      auto start = file.tellg();
+
+      std::size_t count = 0;
+      while (file.ignore(element_type::line_size + 1) &&
+             file.gcount() != 0) // include end-of-line
+        ++count;
+
+      file.clear(); // we reached the end of the file
+      file.seekg(start);
+
+      return count;
+    }
+
+    /// Skip lines with comments (preceeded by *)
+    std::streampos skip_commented_lines(std::ifstream &file) const {
+
+      char c;
+      while (true) {
+        file.get(c);
+        if (c == '*')
           file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
         else
           break;
@@ -383,10 +1012,57 @@ namespace reactions::database {
       return file.tellg();
     }
 
+    /// Map the database file into memory
+    detail::mapped_file map_database() const {
+
+      if (m_db.empty())
+        throw reactions::database_error("The database has not been specified");
+
+      stats::count_file_fallback();
+
+      return detail::mapped_file{m_db};
+    }
+
+    /// Skip lines with comments (preceeded by *) in a view of the file
+    std::string_view skip_commented_lines(std::string_view data) const {
+
+      while (!data.empty() && data.front() == '*') {
+        auto eol = data.find('\n');
+        if (eol == std::string_view::npos)
+          return {};
+        data.remove_prefix(eol + 1);
+      }
+
+      return data;
+    }
+
+    /// Extract the first line of the given view, advancing it to the next one
+    static std::string_view next_line(std::string_view &data) {
+
+      auto eol = data.find('\n');
+
+      auto line = data.substr(0, eol);
+
+      data.remove_prefix(eol == std::string_view::npos ? data.size() : eol + 1);
+
+      return line;
+    }
+
+    /// Count the number of elements in a view of the database
+    std::size_t count_elements(std::string_view data) const {
+
+      std::size_t count = std::count(data.cbegin(), data.cend(), '\n');
+
+      if (!data.empty() && data.back() != '\n')
+        ++count; // the last line has no end-of-line character
+
+      return count;
+    }
+
     /// Read a field with the given index from a line
     template <std::size_t I>
     bool read_field(typename element_type::base_type &tuple,
-                    std::string const &line) const {
+                    std::string_view line) const {
 
       using field = std::tuple_element_t<I, typename element_type::fields_type>;
 
@@ -410,20 +1086,20 @@ namespace reactions::database {
     /// Read all the fields from a line
     template <std::size_t... I>
     bool read_line(typename element_type::base_type &tuple,
-                   std::string const &line, std::index_sequence<I...>) const {
+                   std::string_view line, std::index_sequence<I...>) const {
       return (read_field<I>(tuple, line) && ...);
     }
 
     /// Read all the fields from a line
     bool read_line(typename element_type::base_type &tuple,
-                   std::string const &line) const {
+                   std::string_view line) const {
       return read_line(
           tuple, line,
           std::make_index_sequence<element_type::number_of_fields>());
     }
 
     /// Advance to the next element in the file and read it
-    element_type read_element(std::string const &line) const {
+    element_type read_element(std::string_view line) const {
 
       typename element_type::base_type tuple;
 
@@ -434,60 +1110,674 @@ namespace reactions::database {
       return tuple;
     }
 
+    /*! \brief Iterate over the lines of the database file
+     *
+     * The visitor is called with each line as a \ref std::string_view
+     * object, and must return whether the iteration must stop. Lines are
+     * read from the memory-mapped view of the file or through buffered
+     * reads, depending on the configuration of the database.
+     */
+    template <class Visitor> void for_each_line(Visitor visitor) const {
+
+      if (has_embedded_table()) {
+
+        auto data = skip_commented_lines(m_embedded);
+
+        while (!data.empty())
+          if (visitor(next_line(data)))
+            return;
+
+      } else if (m_use_mmap) {
+
+        auto mapping = map_database();
+
+        auto data = skip_commented_lines(mapping.view());
+
+        while (!data.empty())
+          if (visitor(next_line(data)))
+            return;
+
+      } else {
+
+        auto file = open_database();
+
+        skip_commented_lines(file);
+
+        std::string line;
+
+        while (std::getline(file, line))
+          if (visitor(std::string_view{line})) {
+            file.close();
+            return;
+          }
+
+        file.close();
+      }
+    }
+
+    /// Whether the database path points to a compiled table
+    bool points_to_compiled_table() const {
+
+      if (m_db.empty())
+        return false;
+
+      std::ifstream file{m_db, std::ios::binary};
+
+      if (!file.is_open())
+        return false;
+
+      char magic[sizeof(detail::compiled_table_magic)];
+      file.read(magic, sizeof(magic));
+
+      return file.gcount() == sizeof(magic) &&
+             std::memcmp(magic, detail::compiled_table_magic, sizeof(magic)) ==
+                 0;
+    }
+
+    /// Write a single value of a field to a compiled table
+    template <class T>
+    static void write_binary(std::ostream &out, T const &v) {
+
+      if constexpr (std::is_same_v<T, std::string>) {
+        auto size = static_cast<std::uint32_t>(v.size());
+        out.write(reinterpret_cast<char const *>(&size), sizeof(size));
+        out.write(v.data(), size);
+      } else if constexpr (fields::is_optional_v<T>) {
+        std::uint8_t flag = v.has_value();
+        out.write(reinterpret_cast<char const *>(&flag), sizeof(flag));
+        if (flag)
+          write_binary(out, *v);
+      } else {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Unable to serialize the field type");
+        out.write(reinterpret_cast<char const *>(&v), sizeof(v));
+      }
+    }
+
+    /// Read a single value of a field from a compiled table
+    template <class T>
+    static void read_binary(std::string_view &data, T &v) {
+
+      auto raw = [&data](void *dst, std::size_t size) -> void {
+        if (data.size() < size)
+          throw reactions::database_error("Truncated compiled table");
+        std::memcpy(dst, data.data(), size);
+        data.remove_prefix(size);
+      };
+
+      if constexpr (std::is_same_v<T, std::string>) {
+        std::uint32_t size;
+        raw(&size, sizeof(size));
+        if (data.size() < size)
+          throw reactions::database_error("Truncated compiled table");
+        v.assign(data.data(), size);
+        data.remove_prefix(size);
+      } else if constexpr (fields::is_optional_v<T>) {
+        std::uint8_t flag;
+        raw(&flag, sizeof(flag));
+        if (flag) {
+          typename T::value_type value;
+          read_binary(data, value);
+          v.emplace(std::move(value));
+        } else
+          v.reset();
+      } else {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Unable to serialize the field type");
+        raw(&v, sizeof(v));
+      }
+    }
+
+    /// Write a whole element to a compiled table
+    template <std::size_t... I>
+    static void write_element(std::ostream &out,
+                              typename element_type::base_type const &tuple,
+                              std::index_sequence<I...>) {
+      (write_binary(out, std::get<I>(tuple)), ...);
+    }
+
+    /// Write a whole element to a compiled table
+    static void write_element(std::ostream &out, element_type const &el) {
+      write_element(out, el.field_values(),
+                    std::make_index_sequence<element_type::number_of_fields>());
+    }
+
+    /// Read a whole element from a compiled table
+    template <std::size_t... I>
+    static void read_compiled_element(std::string_view &data,
+                                      typename element_type::base_type &tuple,
+                                      std::index_sequence<I...>) {
+      (read_binary(data, std::get<I>(tuple)), ...);
+    }
+
+    /// Fill the cache from a view of a compiled table
+    void load_compiled(std::string_view data) {
+
+      data.remove_prefix(sizeof(detail::compiled_table_magic));
+
+      std::uint32_t version;
+      read_binary(data, version);
+
+      if (version != detail::compiled_table_version)
+        throw reactions::database_error(
+            "Unsupported version of the compiled table");
+
+      std::uint32_t endianness;
+      read_binary(data, endianness);
+
+      if (endianness != detail::compiled_table_endianness)
+        throw reactions::database_error(
+            "The compiled table was written with a different endianness");
+
+      std::uint64_t count;
+      read_binary(data, count);
+
+      typename cache::cache_type elements;
+      elements.reserve(count);
+
+      for (std::uint64_t i = 0; i < count; ++i) {
+        typename element_type::base_type tuple;
+        read_compiled_element(
+            data, tuple,
+            std::make_index_sequence<element_type::number_of_fields>());
+        elements.emplace_back(std::move(tuple));
+      }
+
+      m_cache.add_database_elements(std::move(elements));
+    }
+
+    /// Columns already built, by field and subfield
+    mutable std::unordered_map<std::type_index, std::shared_ptr<void const>>
+        m_columns;
+
+    /// Cache state the columns were built from
+    mutable typename cache::storage_ptr m_column_snapshot;
+
+    /// Serialize the construction of the columns
+    mutable std::mutex m_column_mutex;
+
+    /// Entries of the bounded cache, most recently used first
+    mutable std::list<element_type> m_lru;
+
+    /// Index of the bounded cache by name
+    mutable std::unordered_map<typename NameField::value_type,
+                               typename std::list<element_type>::iterator>
+        m_lru_by_name;
+
+    /// Index of the bounded cache by ID
+    mutable std::unordered_map<typename IdField::value_type,
+                               typename std::list<element_type>::iterator>
+        m_lru_by_id;
+
+    /// Maximum number of elements of the bounded cache (zero disables it)
+    std::size_t m_lru_capacity = 0;
+
+    /// Serialize the access to the bounded cache
+    mutable std::mutex m_lru_mutex;
+
+    /// Remove the least recently used element (the caches must be locked)
+    void lru_evict() const {
+      auto const &last = m_lru.back();
+      m_lru_by_name.erase(last.template get<NameField>());
+      m_lru_by_id.erase(last.template get<IdField>());
+      m_lru.pop_back();
+    }
+
+    /// Drop the contents of the bounded cache
+    void clear_lru() {
+      std::lock_guard<std::mutex> lock{m_lru_mutex};
+      m_lru.clear();
+      m_lru_by_name.clear();
+      m_lru_by_id.clear();
+    }
+
+    /// Probe the bounded cache, refreshing the entry on a hit
+    template <class Field, class T>
+    std::optional<element_type> lru_find(T const &v) const {
+
+      std::lock_guard<std::mutex> lock{m_lru_mutex};
+
+      if (!m_lru_capacity)
+        return std::nullopt;
+
+      auto probe = [this](auto const &map,
+                          auto const &key) -> std::optional<element_type> {
+        auto it = map.find(key);
+
+        if (it == map.cend())
+          return std::nullopt;
+
+        m_lru.splice(m_lru.begin(), m_lru, it->second); // move to the front
+
+        return *it->second;
+      };
+
+      if constexpr (std::is_same_v<Field, NameField>)
+        return probe(m_lru_by_name, v);
+      else
+        return probe(m_lru_by_id, v);
+    }
+
+    /// Store a freshly-resolved element in the bounded cache
+    void lru_store(element_type const &el) const {
+
+      std::lock_guard<std::mutex> lock{m_lru_mutex};
+
+      if (!m_lru_capacity)
+        return;
+
+      if (m_lru_by_name.find(el.template get<NameField>()) !=
+          m_lru_by_name.cend())
+        return; // stored by a concurrent lookup
+
+      m_lru.emplace_front(el);
+      m_lru_by_name.emplace(el.template get<NameField>(), m_lru.begin());
+      m_lru_by_id.emplace(el.template get<IdField>(), m_lru.begin());
+
+      while (m_lru.size() > m_lru_capacity)
+        lru_evict();
+    }
+
+    /// In-memory index of the database file, mapping keys to line offsets
+    struct scan_index {
+      /// Offsets of the lines by name
+      std::unordered_map<typename NameField::value_type, std::uint64_t>
+          by_name;
+      /// Offsets of the lines by ID
+      std::unordered_map<typename IdField::value_type, std::uint64_t> by_id;
+    };
+
+    /// Lazily-built index of the database file
+    mutable std::optional<scan_index> m_scan_index;
+
+    /// Serialize the construction of the scan index
+    mutable std::mutex m_scan_mutex;
+
+    /// Drop the scan index (the source of the database changed)
+    void reset_scan_index() {
+      std::lock_guard<std::mutex> lock{m_scan_mutex};
+      m_scan_index.reset();
+    }
+
+    /// Path of the sidecar index of the current database file
+    std::string sidecar_index_path() const { return m_db + ".idx"; }
+
+    /*! \brief Modification time of the database file, as an opaque value
+     *
+     * Used to detect stale sidecar indices: the tables are fixed-width,
+     * so a regenerated table with the same number of records has the
+     * same size and the size check alone would accept an index with
+     * wrong offsets. Zero is returned if the time cannot be obtained.
+     */
+    std::uint64_t database_mtime() const {
+
+      std::error_code ec;
+
+      auto time = std::filesystem::last_write_time(m_db, ec);
+
+      if (ec)
+        return 0;
+
+      return static_cast<std::uint64_t>(time.time_since_epoch().count());
+    }
+
+    /*! \brief Get the scan index of the database, building it if needed
+     *
+     * The index maps names and IDs to the offsets of the corresponding
+     * lines, so clash checks and accesses without the cache become hash
+     * probes instead of full scans of the file. On first use the index
+     * is loaded from the sidecar file next to the database, if present
+     * and matching the table size; otherwise it is built from one scan
+     * of the table and persisted to the sidecar (failures to write it,
+     * like on read-only installations, are ignored). The returned
+     * reference stays valid until the source of the database changes.
+     */
+    scan_index const &ensure_scan_index() const {
+
+      std::lock_guard<std::mutex> lock{m_scan_mutex};
+
+      if (m_scan_index)
+        return *m_scan_index;
+
+      auto mapping =
+          has_embedded_table() ? detail::mapped_file{} : map_database();
+
+      auto view = has_embedded_table() ? m_embedded : mapping.view();
+
+      auto mtime = has_embedded_table() ? 0 : database_mtime();
+
+      if (!has_embedded_table() && load_sidecar_index(view.size(), mtime))
+        return *m_scan_index;
+
+      scan_index index;
+
+      auto data = skip_commented_lines(view);
+
+      while (!data.empty()) {
+
+        auto offset = static_cast<std::uint64_t>(data.data() - view.data());
+
+        auto line = next_line(data);
+
+        if (line.empty())
+          continue;
+
+        typename NameField::value_type name;
+        typename IdField::value_type id;
+
+        if (reactions::fields::read_field<typename NameField::range_type>(
+                name, line) == reactions::fields::failed ||
+            reactions::fields::read_field<typename IdField::range_type>(
+                id, line) == reactions::fields::failed)
+          throw reactions::database_error(
+              "Error reading the database; data format not understood");
+
+        index.by_name.emplace(std::move(name), offset);
+        index.by_id.emplace(id, offset);
+      }
+
+      m_scan_index.emplace(std::move(index));
+
+      if (!has_embedded_table())
+        write_sidecar_index(view.size(), mtime);
+
+      return *m_scan_index;
+    }
+
+    /// Try to load the scan index from the sidecar file
+    bool load_sidecar_index(std::uint64_t table_size,
+                            std::uint64_t table_mtime) const {
+
+      std::ifstream file{sidecar_index_path(), std::ios::binary};
+
+      if (!file.is_open())
+        return false;
+
+      detail::mapped_file mapping{sidecar_index_path()};
+
+      auto data = mapping.view();
+
+      if (data.size() < sizeof(detail::sidecar_index_magic) ||
+          std::memcmp(data.data(), detail::sidecar_index_magic,
+                      sizeof(detail::sidecar_index_magic)) != 0)
+        return false;
+
+      data.remove_prefix(sizeof(detail::sidecar_index_magic));
+
+      std::uint32_t version, endianness;
+      std::uint64_t size, mtime, count;
+
+      try {
+        read_binary(data, version);
+        read_binary(data, endianness);
+        read_binary(data, size);
+        read_binary(data, mtime);
+        read_binary(data, count);
+
+        if (version != detail::sidecar_index_version ||
+            endianness != detail::compiled_table_endianness ||
+            size != table_size || mtime != table_mtime)
+          return false; // stale or incompatible index
+
+        scan_index index;
+        index.by_name.reserve(count);
+        index.by_id.reserve(count);
+
+        for (std::uint64_t i = 0; i < count; ++i) {
+
+          typename NameField::value_type name;
+          typename IdField::value_type id;
+          std::uint64_t offset;
+
+          read_binary(data, name);
+          read_binary(data, id);
+          read_binary(data, offset);
+
+          index.by_name.emplace(std::move(name), offset);
+          index.by_id.emplace(id, offset);
+        }
+
+        m_scan_index.emplace(std::move(index));
+      } catch (reactions::database_error &) {
+        return false; // truncated index
+      }
+
+      return true;
+    }
+
+    /// Persist the scan index to the sidecar file, ignoring failures
+    void write_sidecar_index(std::uint64_t table_size,
+                             std::uint64_t table_mtime) const {
+
+      std::ofstream out{sidecar_index_path(), std::ios::binary};
+
+      if (!out.is_open())
+        return; // read-only installation
+
+      out.write(detail::sidecar_index_magic,
+                sizeof(detail::sidecar_index_magic));
+
+      write_binary(out, detail::sidecar_index_version);
+      write_binary(out, detail::compiled_table_endianness);
+      write_binary(out, table_size);
+      write_binary(out, table_mtime);
+
+      // the number of entries is patched once all have been dumped
+      auto count_pos = out.tellp();
+      std::uint64_t count = 0;
+      write_binary(out, count);
+
+      // pair each name with the ID stored at the same offset
+      std::unordered_map<std::uint64_t, typename IdField::value_type>
+          id_at_offset;
+      id_at_offset.reserve(m_scan_index->by_id.size());
+      for (auto const &[id, offset] : m_scan_index->by_id)
+        id_at_offset.emplace(offset, id);
+
+      for (auto const &[name, offset] : m_scan_index->by_name) {
+
+        auto it = id_at_offset.find(offset);
+
+        if (it == id_at_offset.cend())
+          continue; // name and ID shadowed by previous entries
+
+        write_binary(out, name);
+        write_binary(out, it->second);
+        write_binary(out, offset);
+        ++count;
+      }
+
+      out.seekp(count_pos);
+      write_binary(out, count);
+    }
+
+    /// Read the element stored at the given offset of the database
+    element_type read_element_at(std::uint64_t offset) const {
+
+      auto mapping =
+          has_embedded_table() ? detail::mapped_file{} : map_database();
+
+      auto view = has_embedded_table() ? m_embedded : mapping.view();
+
+      if (offset >= view.size())
+        throw reactions::database_error("The database index is stale");
+
+      auto line = view.substr(offset);
+
+      return read_element(line.substr(0, line.find('\n')));
+    }
+
     /// Access an element using the field accessor
     template <class Field, class T> element_type access(T const &v) const {
 
-      switch (m_cache.status()) {
+      [[maybe_unused]] auto timer = stats::time_lookup();
+
+      auto snap = m_cache.snapshot();
+
+      switch (snap->status()) {
       case (cache::full): // the full database is loaded
 
-        for (auto const &el : m_cache)
-          if (el.template get<Field>() == v)
-            return el;
+        if (auto const *el = snap->template find<Field>(v)) {
+          stats::count_cache_hit();
+          return *el;
+        }
+
+        stats::count_cache_miss();
 
         break; // throws an exception
 
       case (cache::user): // only user-registered entries exist
 
-        for (auto const &el : m_cache)
-          if (el.template get<Field>() == v)
-            return el;
+        if (auto const *el = snap->template find<Field>(v)) {
+          stats::count_cache_hit();
+          return *el;
+        }
 
         [[fallthrough]]; // continue as if we had no cache
 
       case (cache::empty): // the cache is empty
 
-        auto file = open_database();
-
-        skip_commented_lines(file);
+        if constexpr (std::is_same_v<Field, NameField> ||
+                      std::is_same_v<Field, IdField>) {
 
-        std::string line;
+          // recently-resolved elements are served from the bounded cache
+          if (auto cached = lru_find<Field>(v)) {
+            stats::count_cache_hit();
+            return std::move(*cached);
+          }
 
-        while (std::getline(file, line)) {
+          stats::count_cache_miss();
 
-          typename Field::value_type ref;
-          auto sc = reactions::fields::read_field<typename Field::range_type>(
-              ref, line);
+          // accesses by name or ID probe the scan index of the file
+          auto const &index = ensure_scan_index();
 
-          if (sc == reactions::fields::failed)
-            throw reactions::database_error(
-                "Error reading the database; data format not understood");
-
-          if (ref == v) {
-            element_type el = read_element(line);
-            file.close();
+          auto resolve = [this](std::uint64_t offset) -> element_type {
+            auto el = read_element_at(offset);
+            lru_store(el);
             return el;
+          };
+
+          if constexpr (std::is_same_v<Field, NameField>) {
+            if (auto it = index.by_name.find(v); it != index.by_name.cend())
+              return resolve(it->second);
+          } else {
+            if (auto it = index.by_id.find(v); it != index.by_id.cend())
+              return resolve(it->second);
           }
-        }
 
-        file.close();
+        } else {
+
+          stats::count_cache_miss();
+
+          std::optional<element_type> found;
+
+          for_each_line([this, &v, &found](std::string_view line) -> bool {
+            typename Field::value_type ref;
+            auto sc = reactions::fields::read_field<typename Field::range_type>(
+                ref, line);
+
+            if (sc == reactions::fields::failed)
+              throw reactions::database_error(
+                  "Error reading the database; data format not understood");
+
+            if (ref == v) {
+              found.emplace(read_element(line));
+              return true;
+            }
+
+            return false;
+          });
+
+          if (found)
+            return std::move(*found);
+        }
       }
 
+      throw_missing_element<Field>(v);
+    }
+
+    /// Throw an error reporting a missing element
+    template <class Field, class T>
+    [[noreturn]] void throw_missing_element(T const &v) const {
       throw reactions::lookup_error(
           (std::string{"Unable to find element with "} + Field::title + " \"" +
            fields::to_string(v) + '"')
               .c_str());
     }
 
+    /// Resolve a batch of elements by the value of the given field
+    template <class Field>
+    std::vector<element_type>
+    bulk_impl(std::vector<typename Field::value_type> const &values) const {
+
+      std::vector<element_type> out;
+      out.reserve(values.size());
+
+      auto snap = m_cache.snapshot();
+
+      if (snap->status() == cache::full) {
+
+        for (auto const &v : values) {
+          if (auto const *el = snap->template find<Field>(v))
+            out.emplace_back(*el);
+          else
+            throw_missing_element<Field>(v);
+        }
+
+        return out;
+      }
+
+      // collect the output positions requested for each distinct value, so
+      // the database file is traversed at most once
+      std::unordered_map<typename Field::value_type, std::vector<std::size_t>>
+          positions;
+      for (std::size_t i = 0; i < values.size(); ++i)
+        positions[values[i]].push_back(i);
+
+      std::vector<std::optional<element_type>> slots(values.size());
+
+      // elements registered by the user are resolved from the cache
+      for (auto it = positions.begin(); it != positions.end();) {
+        if (auto const *el = snap->template find<Field>(it->first)) {
+          for (auto i : it->second)
+            slots[i].emplace(*el);
+          it = positions.erase(it);
+        } else
+          ++it;
+      }
+
+      if (!positions.empty()) {
+
+        for_each_line([this, &positions,
+                       &slots](std::string_view line) -> bool {
+          typename Field::value_type ref;
+          if (reactions::fields::read_field<typename Field::range_type>(
+                  ref, line) == reactions::fields::failed)
+            throw reactions::database_error(
+                "Error reading the database; data format not understood");
+
+          auto it = positions.find(ref);
+
+          if (it != positions.end()) {
+            auto el = read_element(line);
+            for (auto i : it->second)
+              slots[i].emplace(el);
+            positions.erase(it);
+          }
+
+          return positions.empty(); // stop once the batch is resolved
+        });
+
+        if (!positions.empty())
+          throw_missing_element<Field>(positions.cbegin()->first);
+      }
+
+      for (auto &slot : slots)
+        out.emplace_back(std::move(*slot));
+
+      return out;
+    }
+
     database(std::string &&db) : m_db{std::move(db)} {}
     database(database &&) = delete;
     database(database const &) = delete;
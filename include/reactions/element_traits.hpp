@@ -12,6 +12,42 @@
 namespace reactions {
   /// Alias for an element based on a simple string
   using string_element = std::string;
+
+  /*! \brief Lightweight handle to an element interned in a database
+   *
+   * The handle simply points to an element owned by the corresponding
+   * database (see the *intern* member function of the databases), so
+   * processes built on interned elements share a single copy of each
+   * element, and copying their nodes is trivially cheap. The underlying
+   * element is accessed through the * and -> operators.
+   */
+  template <class Element> class interned_element final {
+
+  public:
+    using element_type = Element;
+
+    /// Build the handle from a pointer to an interned element
+    interned_element(Element const *el) : m_element{el} {}
+
+    /// Access the underlying element by reference
+    Element const &operator*() const { return *m_element; }
+    /// Access the underlying element by pointer
+    Element const *operator->() const { return m_element; }
+
+    /// Compare the underlying elements
+    bool operator==(interned_element const &other) const {
+      return m_element == other.m_element || *m_element == *other.m_element;
+    }
+
+    /// \copydoc interned_element::operator==
+    bool operator!=(interned_element const &other) const {
+      return !(*this == other);
+    }
+
+  private:
+    /// Pointer to the element owned by the database
+    Element const *m_element;
+  };
 } // namespace reactions
 
 /*! \brief Handle the properties of elements
@@ -43,6 +79,24 @@ namespace reactions::element_traits {
     static constexpr auto builder = [](std::string const &s) { return s; };
   };
 
+  /// Definition of the properties of an interned PDG element
+  template <>
+  struct properties<reactions::interned_element<reactions::pdg_element>> {
+    using type = reactions::interned_element<reactions::pdg_element>;
+    static constexpr auto builder = [](std::string const &s) {
+      return type{reactions::pdg_database::instance().intern(s)};
+    };
+  };
+
+  /// Definition of the properties of an interned NuBase element
+  template <>
+  struct properties<reactions::interned_element<reactions::nubase_element>> {
+    using type = reactions::interned_element<reactions::nubase_element>;
+    static constexpr auto builder = [](std::string const &s) {
+      return type{reactions::nubase_database::instance().intern(s)};
+    };
+  };
+
   /// Actual `C++` type for the given kind of element
   template <class T> using element_t = typename properties<T>::type;
 
@@ -56,3 +110,13 @@ namespace reactions::element_traits {
   template <class T>
   using builder_tpl_t = std::function<T(std::string const &)> const &;
 } // namespace reactions::element_traits
+
+namespace std {
+  /// Specialization of \ref std::hash for interned elements
+  template <class Element> struct hash<reactions::interned_element<Element>> {
+    /// Hash the underlying element
+    size_t operator()(reactions::interned_element<Element> const &el) const {
+      return hash<Element>{}(*el);
+    }
+  };
+} // namespace std
@@ -74,6 +74,9 @@ namespace reactions {
 
       const char *what() const noexcept { return m_msg; }
 
+      /// Position with respect to the end of the string being parsed
+      std::size_t rpos() const noexcept { return m_rpos; }
+
       syntax_error update(std::string const &str) {
         return {detail::mark_error(str, m_msg, m_rpos).c_str()};
       }
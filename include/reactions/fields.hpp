@@ -4,9 +4,11 @@
 #pragma once
 
 #include <algorithm>
+#include <charconv>
 #include <cmath>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
 
@@ -374,67 +376,80 @@ namespace reactions::fields {
   namespace detail {
 
     /// Convert a range of characters to an integral
-    conversion_status string_to_type(int &out, std::string const &s) {
+    conversion_status string_to_type(int &out, std::string_view s) {
 
       if (s.empty())
         return empty;
 
-      try {
-        out = std::stoi(s);
-      } catch (std::invalid_argument &e) {
+      if (s.front() == '+') // std::from_chars rejects a leading plus sign
+        s.remove_prefix(1);
+
+      auto result = std::from_chars(s.data(), s.data() + s.size(), out);
+
+      if (result.ec != std::errc{})
         return failed;
-      }
 
       return success;
     }
 
     /// Convert a range of characters to a floating point
-    conversion_status string_to_type(float &out, std::string const &s) {
+    template <class FloatType>
+    conversion_status string_to_floating_point(FloatType &out,
+                                               std::string_view s) {
 
       if (s.empty())
         return empty;
 
+      if (s.front() == '+') // std::from_chars rejects a leading plus sign
+        s.remove_prefix(1);
+
+#ifdef __cpp_lib_to_chars
+      auto result = std::from_chars(s.data(), s.data() + s.size(), out);
+
+      if (result.ec != std::errc{})
+        return failed;
+#else
+      // std::from_chars is not available for floating-point types in
+      // old standard libraries; a temporary string must be built for
+      // the standard conversion functions
       try {
-        out = std::stof(s);
+        if constexpr (std::is_same_v<FloatType, float>)
+          out = std::stof(std::string{s});
+        else
+          out = std::stod(std::string{s});
       } catch (std::invalid_argument &e) {
         return failed;
       }
+#endif
 
       return success;
     }
 
-    /// Convert a range of characters to a floating point (double precision)
-    conversion_status string_to_type(double &out, std::string const &s) {
-
-      if (s.empty())
-        return empty;
-
-      try {
-        out = std::stod(s);
-      } catch (std::invalid_argument &e) {
-        return failed;
-      }
+    /// Convert a range of characters to a floating point
+    conversion_status string_to_type(float &out, std::string_view s) {
+      return string_to_floating_point(out, s);
+    }
 
-      return success;
+    /// Convert a range of characters to a floating point (double precision)
+    conversion_status string_to_type(double &out, std::string_view s) {
+      return string_to_floating_point(out, s);
     }
 
     /// Convert a range of characters to a boolean
-    conversion_status string_to_type(bool &out, std::string const &s) {
+    conversion_status string_to_type(bool &out, std::string_view s) {
 
-      if (s.empty())
-        return empty;
+      int value;
 
-      try {
-        out = std::stoi(s);
-      } catch (std::invalid_argument &e) {
-        return failed;
-      }
+      auto sc = string_to_type(value, s);
 
-      return success;
+      if (sc == success)
+        out = value;
+
+      return sc;
     }
 
     /// Convert a range of characters to string
-    conversion_status string_to_type(std::string &out, std::string const &s) {
+    conversion_status string_to_type(std::string &out, std::string_view s) {
 
       out = s;
 
@@ -447,9 +462,7 @@ namespace reactions::fields {
 
   /// Read a field in a line from a file
   template <class Range, class T>
-  conversion_status read_field(T &out, std::string const &s) {
-    // std::from_chars is not correctly implemented in GCC, and
-    // we can not work with std::string_view objects
+  conversion_status read_field(T &out, std::string_view s) {
     auto b = s.find_first_not_of(' ', Range::min);
 
     if (b >= Range::max)
@@ -462,9 +475,7 @@ namespace reactions::fields {
 
   /// Read a field composed by value and an error in a line from a file
   template <class Ranges, class T>
-  conversion_status read_field(value_and_error<T> &out, std::string const &s) {
-    // std::from_chars is not correctly implemented in GCC, and
-    // we can not work with std::string_view objects
+  conversion_status read_field(value_and_error<T> &out, std::string_view s) {
     static_assert(std::tuple_size_v<Ranges> == 3);
 
     auto b = s.find_first_not_of(' ', std::tuple_element_t<0, Ranges>::min);
@@ -487,9 +498,7 @@ namespace reactions::fields {
   template <class Ranges, class ValueType, class TagType>
   conversion_status
   read_field(value_and_error_with_tag<ValueType, TagType> &out,
-             std::string const &s) {
-    // std::from_chars is not correctly implemented in GCC, and
-    // we can not work with std::string_view objects
+             std::string_view s) {
     static_assert(std::tuple_size_v<Ranges> == 3);
 
     auto b = s.find_first_not_of(' ', std::tuple_element_t<0, Ranges>::min);
@@ -511,9 +520,7 @@ namespace reactions::fields {
 
   /// Read a field composed by value and errors in a line from a file
   template <class Ranges, class T>
-  conversion_status read_field(value_and_errors<T> &out, std::string const &s) {
-    // std::from_chars is not correctly implemented in GCC, and
-    // we can not work with std::string_view objects
+  conversion_status read_field(value_and_errors<T> &out, std::string_view s) {
     static_assert(std::tuple_size_v<Ranges> == 3);
 
     auto b = s.find_first_not_of(' ', std::tuple_element_t<0, Ranges>::min);
@@ -8,8 +8,10 @@
 */
 #pragma once
 
+#include <array>
 #include <cstdlib>
 #include <string>
+#include <string_view>
 #include <utility>
 
 /*! \brief Utilities to define smart enumeration types
@@ -78,6 +80,33 @@ namespace reactions::pow_enum {
   template <char... C> constexpr auto parse_string(string_tpl<C...> s) {
     return parse_string_impl(string_group<>{}, string_tpl<>{}, s);
   }
+
+  /*! \brief Build the permutation that sorts a group of strings
+   *
+   * The returned indices allow to run a binary search over the strings
+   * of the group, which are stored in declaration order.
+   */
+  template <std::size_t N>
+  constexpr std::array<std::size_t, N> sort_indices(char const *const *names) {
+
+    std::array<std::size_t, N> out{};
+
+    for (std::size_t i = 0; i < N; ++i)
+      out[i] = i;
+
+    // insertion sort, simple and fast for the small sizes involved
+    for (std::size_t i = 1; i < N; ++i)
+      for (std::size_t j = i;
+           j > 0 &&
+           std::string_view{names[out[j]]} < std::string_view{names[out[j - 1]]};
+           --j) {
+        auto tmp = out[j];
+        out[j] = out[j - 1];
+        out[j - 1] = tmp;
+      }
+
+    return out;
+  }
 } // namespace reactions::pow_enum
 
 /*!
@@ -145,47 +174,52 @@ namespace reactions::pow_enum {
       return index_impl<E>();                                                  \
     }                                                                          \
                                                                                \
-    static enum_name from_string(const char *s) {                              \
-      auto i = 0u;                                                             \
-      for (; i < size; ++i)                                                    \
-        if (strcmp(                                                            \
-                [] {                                                           \
-                  struct constexpr_string_type {                               \
-                    const char *chars = #__VA_ARGS__;                          \
-                  };                                                           \
-                  return reactions::pow_enum::parse_string(                    \
-                      reactions::pow_enum::apply_range<                        \
-                          sizeof(#__VA_ARGS__) - 1,                            \
-                          reactions::pow_enum::string_builder<                 \
-                              constexpr_string_type>::produce>::result{});     \
-                }()                                                            \
-                    .chars[i],                                                 \
-                s) == 0)                                                       \
-          return list[i];                                                      \
+    static constexpr auto name_table() {                                       \
+      struct constexpr_string_type {                                           \
+        const char *chars = #__VA_ARGS__;                                      \
+      };                                                                       \
+      return reactions::pow_enum::parse_string(                                \
+          reactions::pow_enum::apply_range<                                    \
+              sizeof(#__VA_ARGS__) - 1,                                        \
+              reactions::pow_enum::string_builder<                             \
+                  constexpr_string_type>::produce>::result{});                 \
+    }                                                                          \
+                                                                               \
+    static constexpr enum_name from_string(std::string_view s) {               \
+      constexpr auto order =                                                   \
+          reactions::pow_enum::sort_indices<size>(name_table().chars);         \
+      std::size_t lo = 0, hi = size;                                           \
+      while (lo < hi) {                                                        \
+        auto mid = lo + (hi - lo) / 2;                                         \
+        std::string_view ref{name_table().chars[order[mid]]};                  \
+        if (ref < s)                                                           \
+          lo = mid + 1;                                                        \
+        else if (s < ref)                                                      \
+          hi = mid;                                                            \
+        else                                                                   \
+          return list[order[mid]];                                             \
+      }                                                                        \
       return unknown_##enum_name;                                              \
     }                                                                          \
                                                                                \
+    static constexpr enum_name from_string(const char *s) {                    \
+      return from_string(std::string_view{s});                                 \
+    }                                                                          \
+                                                                               \
     static enum_name from_string(std::string const &s) {                       \
-      return from_string(s.c_str());                                           \
+      return from_string(std::string_view{s});                                 \
     }                                                                          \
                                                                                \
-    static const char *to_c_string(enum_name e) {                              \
+    static constexpr const char *to_c_string(enum_name e) {                    \
       auto i = 0u;                                                             \
       for (; i < size; ++i)                                                    \
         if (list[i] == e)                                                      \
           break;                                                               \
-      return [] {                                                              \
-        struct constexpr_string_type {                                         \
-          const char *chars = #__VA_ARGS__;                                    \
-        };                                                                     \
-        return reactions::pow_enum::parse_string(                              \
-            reactions::pow_enum::apply_range<                                  \
-                sizeof(#__VA_ARGS__) - 1,                                      \
-                reactions::pow_enum::string_builder<                           \
-                    constexpr_string_type>::produce>::result{});               \
-      }()                                                                      \
-                 .chars[i];                                                    \
+      return name_table().chars[i];                                            \
+    }                                                                          \
+                                                                               \
+    static constexpr std::string_view to_string(enum_name e) {                 \
+      return to_c_string(e);                                                   \
     }                                                                          \
-    static std::string to_string(enum_name e) { return to_c_string(e); }       \
   }
 // must use a comma
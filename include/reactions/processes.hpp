@@ -4,8 +4,19 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -13,6 +24,8 @@
 #include "reactions/element_traits.hpp"
 #include "reactions/exceptions.hpp"
 #include "reactions/pow_enum.hpp"
+#include "reactions/small_vector.hpp"
+#include "reactions/stats.hpp"
 #include "reactions/tokens.hpp"
 
 namespace reactions {
@@ -114,29 +127,98 @@ namespace reactions {
           continue;
 
         } else
-          ++sit;
+          // jump to the next candidate delimiter instead of inspecting
+          // the string byte by byte
+          sit = tokens::find_next_token(sit + 1, end);
       }
 
       if (sit != start)
         fill_element(start);
     }
 
+    /*! \brief Structured description of a failed parse
+     *
+     * Carries the kind of failure, the unformatted message and, for
+     * syntax errors, the position in the input string where the error
+     * was detected.
+     */
+    struct parse_error {
+
+      /// Kind of failure
+      enum error_kind {
+        syntax, ///< the input string violates the syntax
+        lookup, ///< an element could not be found in the database
+        database ///< the database could not be read
+      };
+
+      /// Kind of failure
+      error_kind kind;
+      /// Description of the failure
+      std::string message;
+      /// Position in the input string where a syntax error was detected
+      /// (\ref std::string::npos for other kinds of failure)
+      std::size_t position;
+    };
+
+    /*! \brief Result of a non-throwing parse
+     *
+     * Holds either the parsed process or a \ref
+     * processes::parse_error. The validity must be checked (through the
+     * boolean conversion) before accessing the value or the error.
+     */
+    template <class Process> class parse_result {
+
+    public:
+      /// Build the result from a parsed process
+      parse_result(Process &&process) : m_result{std::move(process)} {}
+
+      /// Build the result from an error
+      parse_result(parse_error &&error) : m_result{std::move(error)} {}
+
+      /// Whether the parse succeeded
+      explicit operator bool() const {
+        return std::holds_alternative<Process>(m_result);
+      }
+
+      /// Access the parsed process
+      Process &value() { return std::get<Process>(m_result); }
+
+      /// \copydoc parse_result::value
+      Process const &value() const { return std::get<Process>(m_result); }
+
+      /// Access the error
+      parse_error const &error() const {
+        return std::get<parse_error>(m_result);
+      }
+
+    private:
+      /// Either the parsed process or the error
+      std::variant<Process, parse_error> m_result;
+    };
+
     /*! \brief Make a new process (a reaction or a decay)
      *
      * \param str string to parse
      * \param builder function to build the underlying elements
+     * \param alloc allocator used for the collections of nodes of the
+     * process and any of its subprocesses; by default, the default
+     * memory resource is used.
      * \return the new process
      */
     template <class Process>
     Process make_process(std::string const &str,
-                         typename Process::builder_type builder) {
+                         typename Process::builder_type builder,
+                         typename Process::allocator_type alloc = {}) {
+
+      [[maybe_unused]] auto timer = stats::time_parse();
+      stats::count_bytes_tokenized(str.size());
 
       try {
 
         auto sit = str.cbegin();
         auto const send = str.cend();
 
-        Process p{sit, send, builder};
+        Process p{sit, send, builder, alloc};
 
         if (sit != send) {
           if (tokens::match_token<tokens::right_bra>(sit))
@@ -153,6 +235,49 @@ namespace reactions {
         throw e.update(str);
       }
     }
+
+    /*! \brief Make a new process, reporting failures through the result
+     *
+     * Unlike \ref processes::make_process, failures are reported
+     * through the returned \ref processes::parse_result instead of
+     * being thrown to the caller, so validating untrusted candidate
+     * strings in bulk does not pay the cost of formatting and
+     * propagating exceptions out of the parsing code.
+     */
+    template <class Process>
+    parse_result<Process>
+    try_make_process(std::string const &str,
+                     typename Process::builder_type builder,
+                     typename Process::allocator_type alloc = {}) {
+
+      [[maybe_unused]] auto timer = stats::time_parse();
+      stats::count_bytes_tokenized(str.size());
+
+      try {
+
+        auto sit = str.cbegin();
+        auto const send = str.cend();
+
+        Process p{sit, send, builder, alloc};
+
+        if (sit != send)
+          return parse_error{parse_error::syntax,
+                             tokens::match_token<tokens::right_bra>(sit)
+                                 ? "Mismatching braces"
+                                 : "Invalid syntax",
+                             static_cast<std::size_t>(sit - str.cbegin())};
+
+        return parse_result<Process>{std::move(p)};
+
+      } catch (reactions::exceptions::__syntax_error &e) {
+        return parse_error{parse_error::syntax, e.what(),
+                           str.size() - e.rpos()};
+      } catch (reactions::lookup_error &e) {
+        return parse_error{parse_error::lookup, e.what(), std::string::npos};
+      } catch (reactions::database_error &e) {
+        return parse_error{parse_error::database, e.what(), std::string::npos};
+      }
+    }
   } // namespace processes
 
   // Forward declarations
@@ -160,22 +285,109 @@ namespace reactions {
   template <class Element> class reaction;
   template <class Element> class decay;
 
+  /// Internal utilities for the \ref reactions::processes namespace
+  namespace processes::detail {
+    /*! \brief Value-semantic holder of a chain allocated in a memory resource
+     *
+     * Nodes hold nested chains through this object, breaking the
+     * recursive dependency between the two types so the collections of
+     * nodes can provide inline storage. Copies are allocated through
+     * the default memory resource, like any other copy of a process.
+     */
+    template <class T> class box {
+
+    public:
+      /// Allocate the value in the given resource
+      box(T &&value, std::pmr::memory_resource *resource)
+          : m_resource{resource} {
+        m_value = static_cast<T *>(m_resource->allocate(sizeof(T), alignof(T)));
+        try {
+          ::new (static_cast<void *>(m_value)) T(std::move(value));
+        } catch (...) {
+          m_resource->deallocate(m_value, sizeof(T), alignof(T));
+          throw;
+        }
+      }
+
+      /// Copies are allocated through the default memory resource
+      box(box const &other)
+          : m_resource{std::pmr::get_default_resource()} {
+        m_value = static_cast<T *>(m_resource->allocate(sizeof(T), alignof(T)));
+        try {
+          ::new (static_cast<void *>(m_value)) T(*other.m_value);
+        } catch (...) {
+          m_resource->deallocate(m_value, sizeof(T), alignof(T));
+          throw;
+        }
+      }
+
+      /// Move constructor; the value is stolen
+      box(box &&other) noexcept
+          : m_value{other.m_value}, m_resource{other.m_resource} {
+        other.m_value = nullptr;
+      }
+
+      /// Copy assignment operator
+      box &operator=(box const &other) {
+        if (this != &other)
+          *this = box{other};
+        return *this;
+      }
+
+      /// Move assignment operator
+      box &operator=(box &&other) noexcept {
+        std::swap(m_value, other.m_value);
+        std::swap(m_resource, other.m_resource);
+        return *this;
+      }
+
+      ~box() {
+        if (m_value) {
+          m_value->~T();
+          m_resource->deallocate(m_value, sizeof(T), alignof(T));
+        }
+      }
+
+      /// Access the held value
+      T const &operator*() const { return *m_value; }
+
+    private:
+      /// Pointer to the held value
+      T *m_value;
+
+      /// Resource the value was allocated in
+      std::pmr::memory_resource *m_resource;
+    };
+  } // namespace processes::detail
+
   /*! \brief Base class for a process node
    *
    * This abstract class allows to check if the underlying class
-   * is an element or a chain object.
+   * is an element or a chain object. Nested chains are held through an
+   * indirection (allocated in the memory resource of the process), so
+   * the node object itself stays small.
    */
   template <class Element, template <class> class Chain>
   class node final
-      : protected std::variant<element_wrapper<Element>, Chain<Element>> {
+      : protected std::variant<element_wrapper<Element>,
+                               processes::detail::box<Chain<Element>>> {
 
   public:
-    using base_type = std::variant<element_wrapper<Element>, Chain<Element>>;
+    using base_type = std::variant<element_wrapper<Element>,
+                                   processes::detail::box<Chain<Element>>>;
     using element_type = element_wrapper<Element>;
     using chain_type = Chain<Element>;
 
-    /// Use the same constructors as \ref std::variant
-    using base_type::base_type;
+    /// Build the node from an element, caching its hash
+    node(Element &&e)
+        : base_type{element_type{std::move(e)}},
+          m_hash{std::hash<Element>{}(as_element())} {}
+
+    /// Build the node from a chain allocated in the given resource,
+    /// caching its hash
+    node(chain_type &&c, std::pmr::memory_resource *resource)
+        : base_type{processes::detail::box<chain_type>{std::move(c), resource}},
+          m_hash{as_chain().hash()} {}
 
     /// Check if the underlying class is an element
     bool is_element() const {
@@ -214,18 +426,127 @@ namespace reactions {
 
     /// Return the pointer to the underlying object casted to a reaction
     chain_type const &as_chain() const {
-      return std::get<Chain<Element>>(*this);
+      return *std::get<processes::detail::box<chain_type>>(*this);
     }
 
+    /*! \brief Canonical hash of the node
+     *
+     * The hash of the underlying element or chain, computed when the
+     * node is built.
+     */
+    std::size_t hash() const { return m_hash; }
+
   protected:
     /// Return the underlying object casted to a wrapped
     element_type const &as_element_wrapper() const {
       return std::get<element_type>(*this);
     }
+
+    /// Cached hash of the underlying object
+    std::size_t m_hash;
   };
 
-  /// Internal utilities for the \ref reactions::processes namespace
   namespace processes::detail {
+
+    /// Access the element type a process is built on
+    template <class Process> struct process_element;
+
+    /// \copydoc process_element
+    template <class Element> struct process_element<reactions::reaction<Element>> {
+      using type = Element;
+    };
+
+    /// \copydoc process_element
+    template <class Element> struct process_element<reactions::decay<Element>> {
+      using type = Element;
+    };
+
+    /// \copydoc process_element
+    template <class Process>
+    using process_element_t = typename process_element<Process>::type;
+
+    /// Number of lines read from a stream and parsed as a unit
+    static constexpr std::size_t parse_stream_batch_size = 256;
+
+    /*! \brief Run a function over a range of indices, possibly in parallel
+     *
+     * The indices are dealt to the given number of threads through an
+     * atomic counter; any exception thrown by the function is
+     * propagated to the caller.
+     */
+    template <class Function>
+    void parallel_for(std::size_t n, unsigned concurrency, Function func) {
+
+      if (concurrency <= 1 || n < 2) {
+        for (std::size_t i = 0; i < n; ++i)
+          func(i);
+        return;
+      }
+
+      std::atomic<std::size_t> cursor{0};
+      std::exception_ptr error;
+      std::mutex error_mutex;
+
+      std::vector<std::thread> workers;
+      workers.reserve(concurrency);
+      for (auto t = 0u; t < concurrency; ++t)
+        workers.emplace_back([n, &func, &cursor, &error, &error_mutex]() {
+          std::size_t i;
+          while ((i = cursor.fetch_add(1)) < n) {
+            try {
+              func(i);
+            } catch (...) {
+              std::lock_guard<std::mutex> lock{error_mutex};
+              if (!error)
+                error = std::current_exception();
+            }
+          }
+        });
+
+      for (auto &worker : workers)
+        worker.join();
+
+      if (error)
+        std::rethrow_exception(error);
+    }
+
+    /// Combine two hash values in an order-sensitive way
+    inline std::size_t combine_hashes(std::size_t seed, std::size_t h) {
+      return seed ^ (h + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+
+    /*! \brief Scramble a hash value (finalizer of the splitmix64 generator)
+     *
+     * Standard library hashes of integral types are often the identity,
+     * so the values must be scrambled before entering a commutative
+     * combination (the hashes of a particle and its antiparticle would
+     * cancel out otherwise).
+     */
+    inline std::size_t mix_hash(std::size_t h) {
+      h ^= h >> 30;
+      h *= 0xbf58476d1ce4e5b9ull;
+      h ^= h >> 27;
+      h *= 0x94d049bb133111ebull;
+      h ^= h >> 31;
+      return h;
+    }
+
+    /*! \brief Hash a collection of nodes in an order-insensitive way
+     *
+     * The hashes of the nodes are added up, so any permutation of the
+     * nodes provides the same value, matching the comparison of
+     * processes (where the order of the elements is irrelevant).
+     */
+    template <class Nodes> std::size_t hash_nodes(Nodes const &nodes) {
+
+      std::size_t h = nodes.size();
+
+      for (auto const &node : nodes)
+        h += mix_hash(node.hash());
+
+      return h;
+    }
+
     /*! \brief Compare two nodes
      *
      * \param first node to compare
@@ -233,42 +554,44 @@ namespace reactions {
      * \return whether the two nodes are equal or not (processing
      * whether they are reactions, decays or elements).
      */
-    template <class Element, template <class> class Chain>
-    inline bool check_nodes(std::vector<node<Element, Chain>> const &first,
-                            std::vector<node<Element, Chain>> const &second) {
+    template <class Nodes>
+    inline bool check_nodes(Nodes const &first, Nodes const &second) {
 
       auto size = first.size();
 
       if (size != second.size())
         return false;
 
-      // two masks to count the elements that are gone
+      // mask to keep track of the nodes that have already been matched
       std::vector<bool> mask(size, false);
 
       for (auto i = 0u; i < size; ++i) {
 
+        bool matched = false;
+
         for (auto j = 0u; j < size; ++j) {
 
           if (mask[j])
             // already used
             continue;
 
+          if (second[j].hash() != first[i].hash())
+            // the hashes of equal nodes always match
+            continue;
+
           if (second[j].type() != first[i].type())
             // different types
             continue;
 
           switch (first[i].type()) {
           case (processes::node_type::element):
-            if (first[i].as_element() == second[i].as_element())
-              mask[j] = true;
+            matched = (first[i].as_element() == second[j].as_element());
             break;
           case (processes::node_type::reaction):
-            if (first[i].as_chain() == second[i].as_chain())
-              mask[j] = true;
+            matched = (first[i].as_chain() == second[j].as_chain());
             break;
           case (processes::node_type::decay):
-            if (first[i].as_chain() == second[i].as_chain())
-              mask[j] = true;
+            matched = (first[i].as_chain() == second[j].as_chain());
             break;
           case (processes::node_type::unknown_node_type):
             throw reactions::internal_error(
@@ -276,9 +599,16 @@ namespace reactions {
                 "report the bug");
             break;
           }
+
+          if (matched) {
+            mask[j] = true;
+            break;
+          }
         }
-        // if we reach this point, no match has been found for "first[i]"
-        return false;
+
+        if (!matched)
+          // no match has been found for "first[i]"
+          return false;
       }
 
       // all of them have been matched
@@ -330,8 +660,11 @@ namespace reactions {
     using builder_type =
         element_traits::builder_tpl_t<Element>; /// Signature type of an element
                                                 /// builder
+    using allocator_type = std::pmr::polymorphic_allocator<
+        node<Element, reaction>>; /// Allocator for the collections of nodes
     using nodes_type =
-        std::vector<node<Element, reaction>>; /// Collection of elements
+        small_vector<node<Element, reaction>, 4,
+                     allocator_type>; /// Collection of elements
 
     /// Default move constructor
     reaction(reaction &&) = default;
@@ -344,6 +677,36 @@ namespace reactions {
     // No empty constructor
     reaction() = delete;
 
+    /*! \brief Build the reaction from a skeleton and resolved elements
+     *
+     * The skeleton is a reaction of plain strings (typically obtained
+     * from a syntax-only parse), and the map must provide the element
+     * associated to each distinct name through its *at* member
+     * function. Used by \ref reactions::resolve_reaction.
+     */
+    template <class Map>
+    reaction(reaction<string_element> const &skeleton, Map const &resolved,
+             allocator_type alloc = {})
+        : m_reactants{alloc}, m_products{alloc} {
+
+      auto fill = [&resolved, &alloc](nodes_type &nodes, auto const &from) {
+        for (auto const &n : from) {
+          if (n.is_element())
+            nodes.emplace_back(Element{resolved.at(n.as_element())});
+          else
+            nodes.emplace_back(reaction{n.as_chain(), resolved, alloc},
+                               alloc.resource());
+        }
+      };
+
+      fill(m_reactants, skeleton.reactants());
+      fill(m_products, skeleton.products());
+
+      m_hash = processes::detail::combine_hashes(
+          processes::detail::hash_nodes(m_reactants),
+          processes::detail::hash_nodes(m_products));
+    }
+
     /// Get the reactants of the reaction
     nodes_type const &reactants() const { return m_reactants; }
 
@@ -359,6 +722,9 @@ namespace reactions {
      */
     bool operator==(reaction<Element> const &other) const {
 
+      if (m_hash != other.m_hash)
+        return false;
+
       if (m_reactants.size() != other.m_reactants.size() ||
           m_products.size() != other.m_products.size())
         return false;
@@ -372,6 +738,16 @@ namespace reactions {
       return !(*this == other);
     }
 
+    /*! \brief Canonical hash of the reaction
+     *
+     * The hash is computed once, when the reaction is built, and is
+     * insensitive to the order of the nodes on each side of the arrow,
+     * so two equal reactions always have the same hash. It allows to
+     * key processes in unordered containers (through the corresponding
+     * \ref std::hash specialization) and to compare them quickly.
+     */
+    std::size_t hash() const { return m_hash; }
+
   protected:
     /*!\brief Constructor from the string iterators
      *
@@ -381,13 +757,20 @@ namespace reactions {
      * a string.
      */
     reaction(std::string::const_iterator &&begin,
-             std::string::const_iterator const &end, builder_type builder)
-        : reaction{begin, end, builder} {}
+             std::string::const_iterator const &end, builder_type builder,
+             allocator_type alloc = {})
+        : reaction{begin, end, builder, alloc} {}
+
+    template <class Process>
+    friend Process reactions::processes::make_process(
+        std::string const &, typename Process::builder_type,
+        typename Process::allocator_type);
 
     template <class Process>
-    friend Process
-    reactions::processes::make_process(std::string const &,
-                                       typename Process::builder_type);
+    friend processes::parse_result<Process>
+    reactions::processes::try_make_process(std::string const &,
+                                           typename Process::builder_type,
+                                           typename Process::allocator_type);
 
     /*!\brief Constructor from the string iterators
      *
@@ -400,16 +783,20 @@ namespace reactions {
      * a string.
      */
     reaction(std::string::const_iterator &sit,
-             std::string::const_iterator const &end, builder_type builder) {
+             std::string::const_iterator const &end, builder_type builder,
+             allocator_type alloc = {})
+        : m_reactants{alloc}, m_products{alloc} {
 
       nodes_type *current_set = &m_reactants;
 
       auto fill_element =
           [&](std::string::const_iterator const &start) -> void {
+        stats::count_element_built();
         current_set->emplace_back(builder(std::string{start, sit}));
       };
       auto fill_reaction = [&]() -> void {
-        current_set->emplace_back(reaction(sit, end, builder));
+        current_set->emplace_back(reaction(sit, end, builder, alloc),
+                                  alloc.resource());
       };
       auto arrow_switch = [&]() -> void {
         if (!m_reactants.size())
@@ -433,12 +820,18 @@ namespace reactions {
       if (!m_products.size())
         throw reactions::exceptions::__syntax_error("Missing products",
                                                     end - sit);
+
+      m_hash = processes::detail::combine_hashes(
+          processes::detail::hash_nodes(m_reactants),
+          processes::detail::hash_nodes(m_products));
     }
 
     /// Reactants
     nodes_type m_reactants;
     /// Products
     nodes_type m_products;
+    /// Cached hash of the reaction
+    std::size_t m_hash;
   };
 
   /*! \brief Description of a process where head particle generate a set of
@@ -452,7 +845,9 @@ namespace reactions {
   public:
     using element_type = element_wrapper<Element>;
     using builder_type = element_traits::builder_tpl_t<Element>;
-    using nodes_type = std::vector<node<Element, decay>>;
+    using allocator_type =
+        std::pmr::polymorphic_allocator<node<Element, decay>>;
+    using nodes_type = small_vector<node<Element, decay>, 4, allocator_type>;
 
     /// Default move constructor
     decay(decay &&) = default;
@@ -465,6 +860,33 @@ namespace reactions {
 
     decay() = delete;
 
+    /*! \brief Build the decay from a skeleton and resolved elements
+     *
+     * The skeleton is a decay of plain strings (typically obtained from
+     * a syntax-only parse), and the map must provide the element
+     * associated to each distinct name through its *at* member
+     * function. Used by \ref reactions::resolve_decay.
+     */
+    template <class Map>
+    decay(decay<string_element> const &skeleton, Map const &resolved,
+          allocator_type alloc = {})
+        : m_products{alloc} {
+
+      m_head.emplace(Element{resolved.at(skeleton.head())});
+
+      for (auto const &n : skeleton.products()) {
+        if (n.is_element())
+          m_products.emplace_back(Element{resolved.at(n.as_element())});
+        else
+          m_products.emplace_back(decay{n.as_chain(), resolved, alloc},
+                                  alloc.resource());
+      }
+
+      m_hash = processes::detail::combine_hashes(
+          std::hash<Element>{}(head()),
+          processes::detail::hash_nodes(m_products));
+    }
+
     /// Get the head particle of the decay
     Element const &head() const { return *(*m_head); }
 
@@ -474,10 +896,13 @@ namespace reactions {
     /// Comparison operator
     bool operator==(decay<Element> const &other) const {
 
+      if (m_hash != other.m_hash)
+        return false;
+
       if (m_products.size() != other.m_products.size())
         return false;
 
-      return (*m_head == *other.m_head) &&
+      return (head() == other.head()) &&
              processes::detail::check_nodes(m_products, other.m_products);
     }
 
@@ -486,6 +911,16 @@ namespace reactions {
       return !(*this == other);
     }
 
+    /*! \brief Canonical hash of the decay
+     *
+     * The hash is computed once, when the decay is built, and is
+     * insensitive to the order of the products, so two equal decays
+     * always have the same hash. It allows to key processes in
+     * unordered containers (through the corresponding \ref std::hash
+     * specialization) and to compare them quickly.
+     */
+    std::size_t hash() const { return m_hash; }
+
   protected:
     /*!\brief Constructor from the string iterators
      *
@@ -498,13 +933,20 @@ namespace reactions {
      * a string.
      */
     decay(std::string::const_iterator &&begin,
-          std::string::const_iterator const &end, builder_type builder)
-        : decay{begin, end, builder} {}
+          std::string::const_iterator const &end, builder_type builder,
+          allocator_type alloc = {})
+        : decay{begin, end, builder, alloc} {}
+
+    template <class Process>
+    friend Process reactions::processes::make_process(
+        std::string const &, typename Process::builder_type,
+        typename Process::allocator_type);
 
     template <class Process>
-    friend Process
-    reactions::processes::make_process(std::string const &,
-                                       typename Process::builder_type);
+    friend processes::parse_result<Process>
+    reactions::processes::try_make_process(std::string const &,
+                                           typename Process::builder_type,
+                                           typename Process::allocator_type);
 
     /*!\brief Constructor from the string iterators
      *
@@ -517,12 +959,15 @@ namespace reactions {
      * a string.
      */
     decay(std::string::const_iterator &sit,
-          std::string::const_iterator const &end, builder_type builder) {
+          std::string::const_iterator const &end, builder_type builder,
+          allocator_type alloc = {})
+        : m_products{alloc} {
 
       bool fill_products = false; // keep track of the elements we are adding
 
       auto fill_element =
           [&](std::string::const_iterator const &start) -> void {
+        stats::count_element_built();
         if (!m_head) {
           this->m_head.emplace(builder(std::string{start, sit}));
         } else if (fill_products) {
@@ -536,7 +981,8 @@ namespace reactions {
           throw reactions::exceptions::__syntax_error("Missing head",
                                                       end - sit);
         } else if (fill_products) {
-          this->m_products.emplace_back(decay(sit, end, builder));
+          this->m_products.emplace_back(decay(sit, end, builder, alloc),
+                                        alloc.resource());
         } else
           throw reactions::exceptions::__syntax_error("Missing arrow",
                                                       end - sit);
@@ -563,12 +1009,18 @@ namespace reactions {
       if (!m_products.size())
         throw reactions::exceptions::__syntax_error("Expected products",
                                                     end - sit);
+
+      m_hash = processes::detail::combine_hashes(
+          std::hash<Element>{}(head()),
+          processes::detail::hash_nodes(m_products));
     }
 
     /// Head particle
     std::optional<element_type> m_head;
     /// Products
     nodes_type m_products;
+    /// Cached hash of the decay
+    std::size_t m_hash;
   };
 
   /*! \brief Create a new reaction with a custom builder
@@ -614,4 +1066,758 @@ namespace reactions {
   template <class Element> decay<Element> make_decay(std::string const &str) {
     return make_decay_for<Element>(str, element_traits::builder<Element>);
   }
+
+  /*! \brief Parse a stream of processes with a custom builder
+   *
+   * One process per non-empty line is read from the stream, parsed and
+   * passed to the callback. With a concurrency greater than one, the
+   * lines are parsed in batches across that number of threads while the
+   * next batch is being read from the stream, and the callback is
+   * invoked (from the calling thread) in the order of the input lines.
+   * Any error thrown while parsing is propagated to the caller.
+   *
+   * \param in stream to read the processes from
+   * \param callback callable invoked with each parsed process
+   * \param builder function to build the underlying elements
+   * \param concurrency number of threads parsing lines
+   * \return the number of processes parsed
+   */
+  template <class Process, class Callback>
+  std::size_t parse_stream_for(std::istream &in, Callback callback,
+                               typename Process::builder_type builder,
+                               unsigned concurrency = 1) {
+
+    std::size_t count = 0;
+
+    if (concurrency <= 1) {
+
+      std::string line;
+      while (std::getline(in, line)) {
+
+        if (line.empty())
+          continue;
+
+        callback(processes::make_process<Process>(line, builder));
+        ++count;
+      }
+
+      return count;
+    }
+
+    auto read_batch = [&in](std::vector<std::string> &lines) -> void {
+      lines.clear();
+      std::string line;
+      while (lines.size() < processes::detail::parse_stream_batch_size &&
+             std::getline(in, line))
+        if (!line.empty())
+          lines.emplace_back(std::move(line));
+    };
+
+    std::vector<std::string> current, next;
+
+    read_batch(current);
+
+    while (!current.empty()) {
+
+      std::vector<std::optional<Process>> slots(current.size());
+
+      std::atomic<std::size_t> cursor{0};
+      std::exception_ptr error;
+      std::mutex error_mutex;
+
+      std::vector<std::thread> workers;
+      workers.reserve(concurrency);
+      for (auto t = 0u; t < concurrency; ++t)
+        workers.emplace_back([&]() -> void {
+          std::size_t i;
+          while ((i = cursor.fetch_add(1)) < current.size()) {
+            try {
+              slots[i].emplace(
+                  processes::make_process<Process>(current[i], builder));
+            } catch (...) {
+              std::lock_guard<std::mutex> lock{error_mutex};
+              if (!error)
+                error = std::current_exception();
+            }
+          }
+        });
+
+      // overlap the input with the parsing of the current batch; the
+      // workers must be joined whatever happens while reading
+      try {
+        read_batch(next);
+      } catch (...) {
+        for (auto &worker : workers)
+          worker.join();
+        throw;
+      }
+
+      for (auto &worker : workers)
+        worker.join();
+
+      if (error)
+        std::rethrow_exception(error);
+
+      for (auto &slot : slots) {
+        callback(std::move(*slot));
+        ++count;
+      }
+
+      current.swap(next);
+    }
+
+    return count;
+  }
+
+  /*! \brief Parse a stream of processes
+   *
+   * \copydetails parse_stream_for
+   */
+  template <class Process, class Callback>
+  std::size_t parse_stream(std::istream &in, Callback callback,
+                           unsigned concurrency = 1) {
+    return parse_stream_for<Process>(
+        in, callback,
+        element_traits::builder<processes::detail::process_element_t<Process>>,
+        concurrency);
+  }
+
+  /*! \brief Create a new reaction without throwing on failure
+   *
+   * \param str string to parse
+   * \param builder function to build the underlying elements
+   * \return a \ref processes::parse_result with the reaction or the error
+   */
+  template <class Element>
+  processes::parse_result<reaction<Element>>
+  try_make_reaction_for(std::string const &str,
+                        typename reaction<Element>::builder_type builder) {
+    return processes::try_make_process<reaction<Element>>(str, builder);
+  }
+
+  /*! \brief Create a new reaction without throwing on failure
+   *
+   * \param str string to parse
+   * \return a \ref processes::parse_result with the reaction or the error
+   */
+  template <class Element>
+  processes::parse_result<reaction<Element>>
+  try_make_reaction(std::string const &str) {
+    return try_make_reaction_for<Element>(str,
+                                          element_traits::builder<Element>);
+  }
+
+  /*! \brief Create a new decay without throwing on failure
+   *
+   * \param str string to parse
+   * \param builder function to build the underlying elements
+   * \return a \ref processes::parse_result with the decay or the error
+   */
+  template <class Element>
+  processes::parse_result<decay<Element>>
+  try_make_decay_for(std::string const &str,
+                     typename decay<Element>::builder_type builder) {
+    return processes::try_make_process<decay<Element>>(str, builder);
+  }
+
+  /*! \brief Create a new decay without throwing on failure
+   *
+   * \param str string to parse
+   * \return a \ref processes::parse_result with the decay or the error
+   */
+  template <class Element>
+  processes::parse_result<decay<Element>>
+  try_make_decay(std::string const &str) {
+    return try_make_decay_for<Element>(str, element_traits::builder<Element>);
+  }
+
+  /// Internal utilities for the \ref reactions::processes namespace
+  namespace processes::detail {
+    /// Access the element wrapped by a handle, or the element itself
+    template <class Element>
+    decltype(auto) underlying_element(Element const &el) {
+      if constexpr (utils::is_template_specialization_v<
+                        Element, reactions::interned_element>)
+        return *el;
+      else
+        return el;
+    }
+  } // namespace processes::detail
+
+  /*! \brief Whether a decay conserves the electric charge
+   *
+   * The charge of the head must match the sum of the charges of the
+   * products at every level of the decay; a nested decay contributes
+   * the charge of its head and is checked internally as well. The
+   * check runs in a single pass over the nodes, accumulating three
+   * times the charges as integers.
+   */
+  template <class Element> bool is_charge_conserving(decay<Element> const &d) {
+
+    long sum = 0;
+    bool nested_ok = true;
+
+    for (auto const &n : d.products()) {
+      if (n.is_element())
+        sum +=
+            processes::detail::underlying_element(n.as_element()).three_charge();
+      else {
+        auto const &chain = n.as_chain();
+        sum += processes::detail::underlying_element(chain.head()).three_charge();
+        nested_ok = nested_ok && is_charge_conserving(chain);
+      }
+    }
+
+    return nested_ok &&
+           sum ==
+               processes::detail::underlying_element(d.head()).three_charge();
+  }
+
+  /*! \brief Whether a reaction conserves the electric charge
+   *
+   * The sum of the charges of the reactants must match that of the
+   * products at every level of the reaction; a nested reaction
+   * contributes the charge of its reactants and is checked internally
+   * as well.
+   */
+  template <class Element>
+  bool is_charge_conserving(reaction<Element> const &r) {
+
+    bool nested_ok = true;
+
+    // sum the charges of a collection of nodes; nested reactions
+    // contribute the charge of their reactants
+    auto side_charge = [&nested_ok](auto const &nodes, auto &self) -> long {
+      long sum = 0;
+      for (auto const &n : nodes) {
+        if (n.is_element())
+          sum += processes::detail::underlying_element(n.as_element())
+                     .three_charge();
+        else {
+          auto const &chain = n.as_chain();
+          sum += self(chain.reactants(), self);
+          nested_ok = nested_ok && is_charge_conserving(chain);
+        }
+      }
+      return sum;
+    };
+
+    return side_charge(r.reactants(), side_charge) ==
+               side_charge(r.products(), side_charge) &&
+           nested_ok;
+  }
+
+  /*! \brief Difference between the head mass and the sum of product masses
+   *
+   * A positive value indicates that the decay is kinematically allowed.
+   * Nested decays contribute the mass of their head. A \ref
+   * reactions::missing_fields_error is thrown if any of the masses is
+   * not defined.
+   */
+  template <class Element> double mass_excess(decay<Element> const &d) {
+
+    double sum = 0;
+
+    for (auto const &n : d.products()) {
+      if (n.is_element())
+        sum += processes::detail::underlying_element(n.as_element()).mass();
+      else
+        sum += processes::detail::underlying_element(n.as_chain().head()).mass();
+    }
+
+    return processes::detail::underlying_element(d.head()).mass() - sum;
+  }
+
+  /// Evaluate \ref reactions::is_charge_conserving over a collection
+  template <class Process>
+  std::vector<bool> is_charge_conserving(std::vector<Process> const &processes) {
+
+    std::vector<bool> out;
+    out.reserve(processes.size());
+
+    for (auto const &p : processes)
+      out.push_back(is_charge_conserving(p));
+
+    return out;
+  }
+
+  /// Evaluate \ref reactions::mass_excess over a collection
+  template <class Element>
+  std::vector<double> mass_excess(std::vector<decay<Element>> const &decays) {
+
+    std::vector<double> out;
+    out.reserve(decays.size());
+
+    for (auto const &d : decays)
+      out.push_back(mass_excess(d));
+
+    return out;
+  }
+
+  /// Internal utilities for the \ref reactions::processes namespace
+  namespace processes::detail {
+
+    /// Collect the distinct element names of a skeleton decay
+    inline void collect_names(reactions::decay<string_element> const &d,
+                              std::unordered_set<std::string> &names) {
+      names.emplace(d.head());
+      for (auto const &n : d.products())
+        if (n.is_element())
+          names.emplace(n.as_element());
+        else
+          collect_names(n.as_chain(), names);
+    }
+
+    /// Collect the distinct element names of a skeleton reaction
+    inline void collect_names(reactions::reaction<string_element> const &r,
+                              std::unordered_set<std::string> &names) {
+      for (auto const *side : {&r.reactants(), &r.products()})
+        for (auto const &n : *side)
+          if (n.is_element())
+            names.emplace(n.as_element());
+          else
+            collect_names(n.as_chain(), names);
+    }
+
+    /// Resolve each distinct name of a skeleton exactly once
+    template <class Element, class Skeleton, class Builder>
+    std::unordered_map<std::string, Element>
+    resolve_names(Skeleton const &skeleton, Builder const &builder) {
+
+      std::unordered_set<std::string> names;
+      collect_names(skeleton, names);
+
+      std::unordered_map<std::string, Element> resolved;
+      resolved.reserve(names.size());
+
+      for (auto const &name : names)
+        resolved.emplace(name, builder(name));
+
+      return resolved;
+    }
+  } // namespace processes::detail
+
+  /*! \brief Resolve the elements of a syntax-only decay with a custom builder
+   *
+   * Validation and resolution can thus run as separate phases: a
+   * syntax-only parse (a decay built on \ref reactions::string_element,
+   * which touches no database) checks the structure, and this function
+   * later resolves each distinct name exactly once and builds the decay
+   * of resolved elements, so repeated names in the skeleton do not pay
+   * repeated lookups.
+   */
+  template <class Element>
+  decay<Element> resolve_decay_for(decay<string_element> const &skeleton,
+                                   typename decay<Element>::builder_type
+                                       builder) {
+    return decay<Element>{
+        skeleton, processes::detail::resolve_names<Element>(skeleton, builder)};
+  }
+
+  /// Resolve the elements of a syntax-only decay
+  template <class Element>
+  decay<Element> resolve_decay(decay<string_element> const &skeleton) {
+    return resolve_decay_for<Element>(skeleton,
+                                      element_traits::builder<Element>);
+  }
+
+  /*! \brief Resolve the elements of a syntax-only reaction with a custom
+   * builder
+   *
+   * \copydetails resolve_decay_for
+   */
+  template <class Element>
+  reaction<Element>
+  resolve_reaction_for(reaction<string_element> const &skeleton,
+                       typename reaction<Element>::builder_type builder) {
+    return reaction<Element>{
+        skeleton, processes::detail::resolve_names<Element>(skeleton, builder)};
+  }
+
+  /// Resolve the elements of a syntax-only reaction
+  template <class Element>
+  reaction<Element> resolve_reaction(reaction<string_element> const &skeleton) {
+    return resolve_reaction_for<Element>(skeleton,
+                                         element_traits::builder<Element>);
+  }
+
+  /// Value reported by \ref reactions::match for unmatched processes
+  static constexpr std::size_t no_match = static_cast<std::size_t>(-1);
+
+  /*! \brief Remove the duplicated processes of a collection
+   *
+   * The processes are partitioned by their canonical hash and the
+   * buckets are compared across the given number of threads, so
+   * deduplicating large collections avoids the all-pairs comparison.
+   * The first occurrence of each process is kept, and the original
+   * order is preserved.
+   */
+  template <class Process>
+  std::vector<Process>
+  unique(std::vector<Process> &&processes,
+         unsigned concurrency = std::thread::hardware_concurrency()) {
+
+    std::unordered_map<std::size_t, std::vector<std::size_t>> buckets;
+    buckets.reserve(processes.size());
+
+    for (std::size_t i = 0; i < processes.size(); ++i)
+      buckets[processes[i].hash()].emplace_back(i);
+
+    // only buckets with more than one entry need comparisons
+    std::vector<std::vector<std::size_t> const *> work;
+    for (auto const &bucket : buckets)
+      if (bucket.second.size() > 1)
+        work.emplace_back(&bucket.second);
+
+    std::vector<char> duplicate(processes.size(), 0);
+
+    processes::detail::parallel_for(
+        work.size(), concurrency, [&processes, &work, &duplicate](std::size_t w) {
+          auto const &indices = *work[w];
+          for (std::size_t i = 0; i < indices.size(); ++i) {
+
+            if (duplicate[indices[i]])
+              continue;
+
+            for (auto j = i + 1; j < indices.size(); ++j)
+              if (!duplicate[indices[j]] &&
+                  processes[indices[i]] == processes[indices[j]])
+                duplicate[indices[j]] = 1;
+          }
+        });
+
+    std::vector<Process> out;
+    out.reserve(processes.size());
+
+    for (std::size_t i = 0; i < processes.size(); ++i)
+      if (!duplicate[i])
+        out.emplace_back(std::move(processes[i]));
+
+    return out;
+  }
+
+  /*! \brief Match the processes of a collection against another one
+   *
+   * For each process of the first collection, the index of the first
+   * equal process of the second one is reported (or \ref
+   * reactions::no_match if there is none). The second collection is
+   * indexed by the canonical hashes and the first one is processed
+   * across the given number of threads, avoiding the all-pairs
+   * comparison.
+   */
+  template <class Process>
+  std::vector<std::size_t>
+  match(std::vector<Process> const &first, std::vector<Process> const &second,
+        unsigned concurrency = std::thread::hardware_concurrency()) {
+
+    std::unordered_map<std::size_t, std::vector<std::size_t>> buckets;
+    buckets.reserve(second.size());
+
+    for (std::size_t j = 0; j < second.size(); ++j)
+      buckets[second[j].hash()].emplace_back(j);
+
+    std::vector<std::size_t> out(first.size(), no_match);
+
+    processes::detail::parallel_for(
+        first.size(), concurrency,
+        [&first, &second, &buckets, &out](std::size_t i) {
+          auto it = buckets.find(first[i].hash());
+
+          if (it == buckets.cend())
+            return;
+
+          for (auto j : it->second)
+            if (second[j] == first[i]) {
+              out[i] = j;
+              break;
+            }
+        });
+
+    return out;
+  }
+
+  /*! \brief Flattened representation of a process tree
+   *
+   * The nodes of a reaction or a decay are laid out in preorder in one
+   * contiguous array, so whole-tree traversals become linear scans over
+   * memory instead of walks through scattered variant nodes. Each entry
+   * records the total number of entries of its subtree, which allows to
+   * skip it, and (for reactions) the number of entries of the reactant
+   * segment. The entries point into the process the representation was
+   * built from, which must therefore outlive it and must not be moved
+   * while the flattened form is in use (the nodes of small processes
+   * are stored within the process object itself).
+   */
+  template <class Element> class flat_process {
+
+  public:
+    /// Entry of the flattened tree
+    struct entry {
+      /// Type of the node
+      processes::node_type type;
+      /// The element, or the head of a decay (null for reactions)
+      Element const *element;
+      /// Total number of entries of the subtree, including this one
+      std::uint32_t size;
+      /// Number of entries of the reactant segment (reactions only)
+      std::uint32_t boundary;
+
+      /// Whether the entry corresponds to an element
+      bool is_element() const {
+        return type == processes::node_type::element;
+      }
+    };
+
+    using entries_type = std::vector<entry>;
+    using const_iterator_type = typename entries_type::const_iterator;
+
+    /// Flatten a decay
+    explicit flat_process(decay<Element> const &d) { append(d); }
+
+    /// Flatten a reaction
+    explicit flat_process(reaction<Element> const &r) { append(r); }
+
+    /// Number of entries
+    std::size_t size() const { return m_entries.size(); }
+
+    /// Access an entry
+    entry const &operator[](std::size_t i) const { return m_entries[i]; }
+
+    /// Begining of the entries, in preorder
+    const_iterator_type begin() const { return m_entries.cbegin(); }
+
+    /// End of the entries
+    const_iterator_type end() const { return m_entries.cend(); }
+
+    /*! \brief Visit every entry of the tree in preorder
+     *
+     * The visitor is called with each entry; the whole traversal is a
+     * single linear scan over contiguous memory.
+     */
+    template <class Visitor> void visit(Visitor visitor) const {
+      for (auto const &e : m_entries)
+        visitor(e);
+    }
+
+  private:
+    /// Append a decay and its products
+    void append(decay<Element> const &d) {
+
+      auto index = m_entries.size();
+
+      m_entries.push_back(
+          {processes::node_type::decay, &d.head(), 0u, 0u});
+
+      for (auto const &n : d.products())
+        append_node(n);
+
+      m_entries[index].size =
+          static_cast<std::uint32_t>(m_entries.size() - index);
+    }
+
+    /// Append a reaction, its reactants and its products
+    void append(reaction<Element> const &r) {
+
+      auto index = m_entries.size();
+
+      m_entries.push_back(
+          {processes::node_type::reaction, nullptr, 0u, 0u});
+
+      for (auto const &n : r.reactants())
+        append_node(n);
+
+      m_entries[index].boundary =
+          static_cast<std::uint32_t>(m_entries.size() - index - 1);
+
+      for (auto const &n : r.products())
+        append_node(n);
+
+      m_entries[index].size =
+          static_cast<std::uint32_t>(m_entries.size() - index);
+    }
+
+    /// Append a node (an element or a nested chain)
+    template <class Node> void append_node(Node const &n) {
+      if (n.is_element())
+        m_entries.push_back(
+            {processes::node_type::element, &n.as_element(), 1u, 0u});
+      else
+        append(n.as_chain());
+    }
+
+    /// Entries of the tree, in preorder
+    entries_type m_entries;
+  };
+
+  /*! \brief Memoizing factory of processes
+   *
+   * The registry parses each distinct string once and caches the
+   * resulting process, handing out shared pointers to the immutable
+   * object; repeated requests for the same string avoid the
+   * tokenization and the element resolution entirely and only pay a
+   * hash lookup plus a reference-count increment. The registry can be
+   * used concurrently from several threads, with cache hits taking a
+   * shared lock. The memory held by the memoized processes is released
+   * when the registry is cleared or destroyed and the last handles
+   * disappear.
+   */
+  template <class Process> class process_registry {
+
+  public:
+    using element_type = processes::detail::process_element_t<Process>;
+    using builder_type = std::function<element_type(std::string const &)>;
+    using process_ptr = std::shared_ptr<Process const>;
+
+    /// Build a registry using the default element builder
+    process_registry() : m_builder{element_traits::builder<element_type>} {}
+
+    /// Build a registry with a custom element builder
+    explicit process_registry(builder_type builder)
+        : m_builder{std::move(builder)} {}
+
+    /*! \brief Get the process associated to the given string
+     *
+     * The string is parsed on the first request and served from the
+     * cache afterwards. Parsing errors are propagated to the caller
+     * and nothing is stored for the offending string.
+     */
+    process_ptr operator()(std::string const &str) {
+
+      {
+        std::shared_lock<std::shared_mutex> lock{m_mutex};
+
+        auto it = m_registry.find(str);
+
+        if (it != m_registry.cend())
+          return it->second;
+      }
+
+      auto process = std::make_shared<Process const>(
+          processes::make_process<Process>(str, m_builder));
+
+      std::lock_guard<std::shared_mutex> lock{m_mutex};
+
+      // in case of a race, the process stored by the first writer wins
+      return m_registry.emplace(str, std::move(process)).first->second;
+    }
+
+    /// Number of distinct strings parsed so far
+    std::size_t size() const {
+      std::shared_lock<std::shared_mutex> lock{m_mutex};
+      return m_registry.size();
+    }
+
+    /// Drop all the memoized processes
+    void clear() {
+      std::lock_guard<std::shared_mutex> lock{m_mutex};
+      m_registry.clear();
+    }
+
+  private:
+    /// Function building the elements of the processes
+    builder_type m_builder;
+
+    /// Memoized processes by input string
+    std::unordered_map<std::string, process_ptr> m_registry;
+
+    /// Protect the registry; readers only take a shared lock
+    mutable std::shared_mutex m_mutex;
+  };
+
+  /// Memoizing factory of reactions
+  template <class Element>
+  using reaction_registry = process_registry<reaction<Element>>;
+
+  /// Memoizing factory of decays
+  template <class Element> using decay_registry = process_registry<decay<Element>>;
+
+  /*! \brief Monotonic memory arena for processes
+   *
+   * The collections of nodes of any process built in the arena (and of
+   * any of its subprocesses) are carved out of the buffer of the arena,
+   * whose memory is released as a whole when the arena is destroyed.
+   * The arena must therefore outlive any process built in it, including
+   * objects the processes are moved to. Copies of a process are
+   * allocated through the default memory resource, and are thus not
+   * tied to the arena.
+   */
+  using arena = std::pmr::monotonic_buffer_resource;
+
+  /*! \brief Create a new reaction in the given arena with a custom builder
+   *
+   * \param resource arena (or any other memory resource) providing the
+   * memory for the collections of nodes
+   * \param str string to parse
+   * \param builder function to build the underlying elements
+   * \return the new reaction
+   */
+  template <class Element>
+  reaction<Element>
+  make_reaction_in(std::pmr::memory_resource &resource, std::string const &str,
+                   typename reaction<Element>::builder_type builder) {
+    return processes::make_process<reaction<Element>>(
+        str, builder, typename reaction<Element>::allocator_type{&resource});
+  }
+
+  /*! \brief Create a new reaction in the given arena
+   *
+   * \param resource arena (or any other memory resource) providing the
+   * memory for the collections of nodes
+   * \param str string to parse
+   * \return the new reaction
+   */
+  template <class Element>
+  reaction<Element> make_reaction_in(std::pmr::memory_resource &resource,
+                                     std::string const &str) {
+    return make_reaction_in<Element>(resource, str,
+                                     element_traits::builder<Element>);
+  }
+
+  /*! \brief Create a new decay in the given arena with a custom builder
+   *
+   * \param resource arena (or any other memory resource) providing the
+   * memory for the collections of nodes
+   * \param str string to parse
+   * \param builder function to build the underlying elements
+   * \return the new decay
+   */
+  template <class Element>
+  decay<Element> make_decay_in(std::pmr::memory_resource &resource,
+                               std::string const &str,
+                               typename decay<Element>::builder_type builder) {
+    return processes::make_process<decay<Element>>(
+        str, builder, typename decay<Element>::allocator_type{&resource});
+  }
+
+  /*! \brief Create a new decay in the given arena
+   *
+   * \param resource arena (or any other memory resource) providing the
+   * memory for the collections of nodes
+   * \param str string to parse
+   * \return the new decay
+   */
+  template <class Element>
+  decay<Element> make_decay_in(std::pmr::memory_resource &resource,
+                               std::string const &str) {
+    return make_decay_in<Element>(resource, str,
+                                  element_traits::builder<Element>);
+  }
 } // namespace reactions
+
+namespace std {
+  /// Specialization of \ref std::hash for reactions
+  template <class Element> struct hash<reactions::reaction<Element>> {
+    /// Return the cached canonical hash of the reaction
+    size_t operator()(reactions::reaction<Element> const &r) const {
+      return r.hash();
+    }
+  };
+
+  /// Specialization of \ref std::hash for decays
+  template <class Element> struct hash<reactions::decay<Element>> {
+    /// Return the cached canonical hash of the decay
+    size_t operator()(reactions::decay<Element> const &d) const {
+      return d.hash();
+    }
+  };
+} // namespace std
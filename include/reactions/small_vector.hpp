@@ -0,0 +1,239 @@
+/*! \file
+  \brief Define a vector with inline storage for a few elements
+ */
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace reactions {
+
+  /*! \brief Vector with inline storage for a small number of elements
+   *
+   * The first *N* elements are stored within the object itself, so no
+   * allocation is done until the inline capacity is exceeded; further
+   * growth spills to the given allocator. The interface follows the
+   * subset of \ref std::vector used by the processes of this package.
+   */
+  template <class T, std::size_t N, class Allocator = std::allocator<T>>
+  class small_vector {
+
+  public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    /// Build an empty vector with the given allocator
+    small_vector(allocator_type const &alloc = {}) : m_alloc{alloc} {
+      m_data = inline_data();
+    }
+
+    /// Copy constructor
+    small_vector(small_vector const &other)
+        : m_alloc{std::allocator_traits<allocator_type>::
+                      select_on_container_copy_construction(other.m_alloc)} {
+      m_data = inline_data();
+      reserve(other.m_size);
+      for (auto const &v : other)
+        emplace_back(v);
+    }
+
+    /*! \brief Move constructor; inline elements are moved one by one
+     *
+     * Never allocates: the allocator is taken from the source, so
+     * spilled storage is always stolen, and inline contents fit the
+     * inline capacity. The constructor is therefore nothrow whenever
+     * the element moves are, keeping containers of processes moving
+     * their contents on reallocation instead of copying them.
+     */
+    small_vector(small_vector &&other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+        : m_alloc{std::move(other.m_alloc)} {
+      m_data = inline_data();
+      take_contents(other);
+    }
+
+    /// Copy assignment operator
+    small_vector &operator=(small_vector const &other) {
+
+      if (this == &other)
+        return *this;
+
+      clear();
+
+      if constexpr (std::allocator_traits<allocator_type>::
+                        propagate_on_container_copy_assignment::value) {
+        release_storage();
+        m_alloc = other.m_alloc;
+      }
+
+      reserve(other.m_size);
+      for (auto const &v : other)
+        emplace_back(v);
+
+      return *this;
+    }
+
+    /// Move assignment operator
+    small_vector &operator=(small_vector &&other) {
+
+      if (this == &other)
+        return *this;
+
+      clear();
+      release_storage();
+
+      if constexpr (std::allocator_traits<allocator_type>::
+                        propagate_on_container_move_assignment::value)
+        m_alloc = std::move(other.m_alloc);
+
+      take_contents(other);
+
+      return *this;
+    }
+
+    ~small_vector() {
+      clear();
+      release_storage();
+    }
+
+    /// Number of stored elements
+    size_type size() const { return m_size; }
+
+    /// Whether the vector is empty
+    bool empty() const { return m_size == 0; }
+
+    /// Allocator used when the inline capacity is exceeded
+    allocator_type get_allocator() const { return m_alloc; }
+
+    /// Begining of the stored elements
+    iterator begin() { return m_data; }
+    /// \copydoc small_vector::begin
+    const_iterator begin() const { return m_data; }
+    /// \copydoc small_vector::begin
+    const_iterator cbegin() const { return m_data; }
+
+    /// End of the stored elements
+    iterator end() { return m_data + m_size; }
+    /// \copydoc small_vector::end
+    const_iterator end() const { return m_data + m_size; }
+    /// \copydoc small_vector::end
+    const_iterator cend() const { return m_data + m_size; }
+
+    /// Access an element
+    T &operator[](size_type i) { return m_data[i]; }
+    /// \copydoc small_vector::operator[]
+    T const &operator[](size_type i) const { return m_data[i]; }
+
+    /// Access an element, checking the bounds
+    T const &at(size_type i) const {
+      if (i >= m_size)
+        throw std::out_of_range("small_vector::at");
+      return m_data[i];
+    }
+
+    /// First stored element
+    T const &front() const { return m_data[0]; }
+    /// Last stored element
+    T const &back() const { return m_data[m_size - 1]; }
+
+    /// Ensure the capacity is at least the given number of elements
+    void reserve(size_type n) {
+
+      if (n <= m_capacity)
+        return;
+
+      auto *data =
+          std::allocator_traits<allocator_type>::allocate(m_alloc, n);
+
+      for (size_type i = 0; i < m_size; ++i) {
+        std::allocator_traits<allocator_type>::construct(
+            m_alloc, data + i, std::move(m_data[i]));
+        std::allocator_traits<allocator_type>::destroy(m_alloc, m_data + i);
+      }
+
+      release_storage();
+
+      m_data = data;
+      m_capacity = n;
+    }
+
+    /// Add a new element at the end of the vector
+    template <class... Args> T &emplace_back(Args &&...args) {
+
+      if (m_size == m_capacity)
+        reserve(2 * m_capacity);
+
+      std::allocator_traits<allocator_type>::construct(
+          m_alloc, m_data + m_size, std::forward<Args>(args)...);
+
+      return m_data[m_size++];
+    }
+
+    /// Remove all the elements, keeping the storage
+    void clear() {
+      for (size_type i = 0; i < m_size; ++i)
+        std::allocator_traits<allocator_type>::destroy(m_alloc, m_data + i);
+      m_size = 0;
+    }
+
+  private:
+    /// Pointer to the inline storage
+    T *inline_data() {
+      return reinterpret_cast<T *>(&m_storage[0]);
+    }
+
+    /// Whether the elements live in the inline storage
+    bool is_inline() const {
+      return m_data ==
+             reinterpret_cast<T const *>(&m_storage[0]);
+    }
+
+    /// Deallocate the spilled storage, if any, going back to the inline one
+    void release_storage() {
+      if (!is_inline()) {
+        std::allocator_traits<allocator_type>::deallocate(m_alloc, m_data,
+                                                          m_capacity);
+        m_data = inline_data();
+        m_capacity = N;
+      }
+    }
+
+    /// Steal or move the contents of another vector (which must be empty)
+    void take_contents(small_vector &other) {
+
+      if (other.is_inline() || m_alloc != other.m_alloc) {
+        reserve(other.m_size);
+        for (auto &v : other)
+          emplace_back(std::move(v));
+        other.clear();
+      } else {
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+        other.m_data = other.inline_data();
+        other.m_size = 0;
+        other.m_capacity = N;
+      }
+    }
+
+    /// Inline storage for the first elements
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage[N];
+
+    /// Pointer to the stored elements
+    T *m_data = nullptr;
+
+    /// Number of stored elements
+    size_type m_size = 0;
+
+    /// Current capacity
+    size_type m_capacity = N;
+
+    /// Allocator used when the inline capacity is exceeded
+    allocator_type m_alloc;
+  };
+} // namespace reactions
@@ -0,0 +1,152 @@
+/*! \file
+  \brief Lightweight instrumentation of the hot paths of the package
+
+  The counters are compiled out by default: all the recording functions
+  are empty inline functions unless the REACTIONS_ENABLE_STATS macro is
+  defined before including the headers of the package (it must be
+  defined consistently across all the translation units of a program).
+  When enabled, atomic counters and monotonic-clock timings are
+  maintained for the database accesses and the parsing of processes,
+  and can be collected through \ref reactions::stats::snapshot.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace reactions::stats {
+
+  /// Snapshot of the instrumentation counters
+  struct counters {
+    /// Database lookups resolved from the cache
+    std::uint64_t cache_hits;
+    /// Database lookups not resolved from the cache
+    std::uint64_t cache_misses;
+    /// Times the database file was opened or mapped
+    std::uint64_t file_fallbacks;
+    /// Elements built while parsing processes
+    std::uint64_t elements_built;
+    /// Characters processed by the parser
+    std::uint64_t bytes_tokenized;
+    /// Time spent in database accesses (nanoseconds)
+    std::uint64_t lookup_time_ns;
+    /// Time spent parsing processes (nanoseconds)
+    std::uint64_t parse_time_ns;
+  };
+
+#ifdef REACTIONS_ENABLE_STATS
+
+  /// Internal counters of the instrumentation
+  namespace detail {
+    inline std::atomic<std::uint64_t> cache_hits{0};
+    inline std::atomic<std::uint64_t> cache_misses{0};
+    inline std::atomic<std::uint64_t> file_fallbacks{0};
+    inline std::atomic<std::uint64_t> elements_built{0};
+    inline std::atomic<std::uint64_t> bytes_tokenized{0};
+    inline std::atomic<std::uint64_t> lookup_time_ns{0};
+    inline std::atomic<std::uint64_t> parse_time_ns{0};
+  } // namespace detail
+
+  /// Record a database lookup resolved from the cache
+  inline void count_cache_hit() {
+    detail::cache_hits.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Record a database lookup not resolved from the cache
+  inline void count_cache_miss() {
+    detail::cache_misses.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Record an access to the database file
+  inline void count_file_fallback() {
+    detail::file_fallbacks.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Record the construction of an element while parsing
+  inline void count_element_built() {
+    detail::elements_built.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// Record the number of characters processed by the parser
+  inline void count_bytes_tokenized(std::uint64_t n) {
+    detail::bytes_tokenized.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /// Accumulate the lifetime of the object into the given counter
+  class scoped_timer {
+
+  public:
+    /// Start timing, accumulating into the given counter
+    scoped_timer(std::atomic<std::uint64_t> &counter)
+        : m_counter{counter}, m_start{std::chrono::steady_clock::now()} {}
+
+    ~scoped_timer() {
+      m_counter.fetch_add(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - m_start)
+              .count(),
+          std::memory_order_relaxed);
+    }
+
+  private:
+    /// Counter to accumulate into
+    std::atomic<std::uint64_t> &m_counter;
+    /// Time the object was built
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  /// Time a database access for the duration of the current scope
+  inline scoped_timer time_lookup() { return {detail::lookup_time_ns}; }
+
+  /// Time a process parse for the duration of the current scope
+  inline scoped_timer time_parse() { return {detail::parse_time_ns}; }
+
+  /// Collect the current values of all the counters
+  inline counters snapshot() {
+    return {detail::cache_hits.load(),      detail::cache_misses.load(),
+            detail::file_fallbacks.load(),  detail::elements_built.load(),
+            detail::bytes_tokenized.load(), detail::lookup_time_ns.load(),
+            detail::parse_time_ns.load()};
+  }
+
+  /// Set all the counters back to zero
+  inline void reset() {
+    detail::cache_hits = 0;
+    detail::cache_misses = 0;
+    detail::file_fallbacks = 0;
+    detail::elements_built = 0;
+    detail::bytes_tokenized = 0;
+    detail::lookup_time_ns = 0;
+    detail::parse_time_ns = 0;
+  }
+
+#else
+
+  /// \copydoc reactions::stats (disabled; all functions are no-ops)
+  inline void count_cache_hit() {}
+  /// \copydoc count_cache_hit
+  inline void count_cache_miss() {}
+  /// \copydoc count_cache_hit
+  inline void count_file_fallback() {}
+  /// \copydoc count_cache_hit
+  inline void count_element_built() {}
+  /// \copydoc count_cache_hit
+  inline void count_bytes_tokenized(std::uint64_t) {}
+
+  /// Timer with no effect (the instrumentation is disabled)
+  class scoped_timer {};
+
+  /// \copydoc count_cache_hit
+  inline scoped_timer time_lookup() { return {}; }
+  /// \copydoc count_cache_hit
+  inline scoped_timer time_parse() { return {}; }
+
+  /// Collect the counters (all zero; the instrumentation is disabled)
+  inline counters snapshot() { return {}; }
+
+  /// \copydoc count_cache_hit
+  inline void reset() {}
+
+#endif
+} // namespace reactions::stats
@@ -3,7 +3,9 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <utility>
 
@@ -44,6 +46,67 @@ namespace reactions::tokens {
     return ((C == c) || ...);
   }
 
+  /// Internal utilities for the \ref reactions::tokens namespace
+  namespace detail {
+
+    /// Word with the lowest bit of each byte set
+    static constexpr std::uint64_t swar_ones = 0x0101010101010101ull;
+
+    /// Mark the bytes of the word equal to the given character
+    constexpr std::uint64_t swar_match(std::uint64_t word, char c) {
+      auto x = word ^ (swar_ones * static_cast<unsigned char>(c));
+      return (x - swar_ones) & ~x & (swar_ones * 0x80u);
+    }
+
+    /// Index of the first marked byte of a mask
+    inline std::size_t swar_first(std::uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+      return static_cast<std::size_t>(__builtin_ctzll(mask)) / 8u;
+#else
+      std::size_t i = 0;
+      while ((mask & 0xffu) == 0) {
+        mask >>= 8;
+        ++i;
+      }
+      return i;
+#endif
+    }
+  } // namespace detail
+
+  /*! \brief Advance to the next character that can start a token
+   *
+   * The characters are inspected a word at a time, marking the bytes
+   * that match a space, a brace or the first character of an arrow, so
+   * the parser jumps from delimiter to delimiter instead of inspecting
+   * the string byte by byte. The returned iterator points to the first
+   * candidate delimiter at or after the given position, or to the end
+   * of the string.
+   */
+  inline std::string::const_iterator
+  find_next_token(std::string::const_iterator it,
+                  std::string::const_iterator const &end) {
+
+    while (end - it >= 8) {
+
+      std::uint64_t word;
+      std::memcpy(&word, &(*it), sizeof(word));
+
+      auto mask = detail::swar_match(word, ' ') |
+                  detail::swar_match(word, '{') |
+                  detail::swar_match(word, '}') | detail::swar_match(word, '-');
+
+      if (mask)
+        return it + detail::swar_first(mask);
+
+      it += sizeof(word);
+    }
+
+    while (it != end && !match_any<' ', '{', '}', '-'>(*it))
+      ++it;
+
+    return it;
+  }
+
   /// Check if the given character is within the range defined by the template
   /// arguments
   template <char C0, char C1> constexpr bool match_range(char c) {
@@ -43,7 +43,7 @@ namespace reactions {
     struct none {};
 
     /// Compute the scale factor for the given unit
-    auto scale_factor_for(energy_units u) {
+    constexpr auto scale_factor_for(energy_units u) {
       switch (u) {
       case (energy_units::eV):
         return 1.;
@@ -62,14 +62,11 @@ namespace reactions {
       }
 
       throw internal_error(
-          (std::string{
-               "Attempt to compute a scale factor of an unknown unit: \""} +
-           energy_units_properties::to_string(u) + '"')
-              .c_str());
+          "Attempt to compute a scale factor of an unknown energy unit");
     }
 
     /// Compute the scale factor for the given unit
-    auto scale_factor_for(time_units u) {
+    constexpr auto scale_factor_for(time_units u) {
 
       switch (u) {
       case (time_units::ys):
@@ -119,10 +116,7 @@ namespace reactions {
       }
 
       throw internal_error(
-          (std::string{
-               "Attempt to compute a scale factor of an unknown unit: \""} +
-           time_units_properties::to_string(u) + '"')
-              .c_str());
+          "Attempt to compute a scale factor of an unknown time unit");
     }
 
     /// Use the template argument as a reference to determine scale factors
@@ -247,5 +241,30 @@ namespace reactions {
     static constexpr accessor_with_units_t<Field, Subfield...>
         accessor_with_units;
 
+    /*! \brief Object to access fields scaling with a unit fixed at compile
+     * time
+     *
+     * The scale factor is a constant expression baked into the call
+     * site, so no system of units is consulted and no runtime switch is
+     * executed on access.
+     */
+    template <auto Unit, class Field, class... Subfield> struct accessor_as_t {
+      /// Access the value of the subfield and scale it
+      template <class T> constexpr auto operator()(T const &f) const {
+        using R = typename Field::units_reference_type;
+        static_assert(!std::is_same_v<R, units::none>,
+                      "The field has no units");
+        static_assert(std::is_same_v<typename R::units_type, decltype(Unit)>,
+                      "The given unit does not match the units of the field");
+        constexpr auto factor = R::scale_factor(Unit);
+        return factor * accessor<Field, Subfield...>(f);
+      }
+    };
+
+    /// Static object to access the fields of a tuple-like object with a
+    /// unit fixed at compile time
+    template <auto Unit, class Field, class... Subfield>
+    static constexpr accessor_as_t<Unit, Field, Subfield...> accessor_as;
+
   } // namespace units
 } // namespace reactions
@@ -5,7 +5,7 @@ try:
 
     from .capi import (
         # types
-        node, reaction, decay,
+        node, reaction, decay, decay_tree,
         string_element, nubase_element, pdg_element,
         nubase_database_sgl, nubase_system_of_units_sgl,
         pdg_database_sgl, pdg_system_of_units_sgl,
@@ -30,7 +30,7 @@ try:
     del os
 
     # Variables exported
-    __all__ = ['node', 'reaction', 'decay',
+    __all__ = ['node', 'reaction', 'decay', 'decay_tree',
                'string_element', 'nubase_element', 'pdg_element',
                'nubase_database', 'nubase_database_sgl', 'nubase_system_of_units', 'nubase_system_of_units_sgl',
                'pdg_database', 'pdg_database_sgl', 'pdg_system_of_units', 'pdg_system_of_units_sgl',
@@ -3,6 +3,7 @@
 
 #include "chains.hpp"
 #include "database.hpp"
+#include "decay_tree.hpp"
 #include "element_nubase.hpp"
 #include "element_pdg.hpp"
 #include "element_string.hpp"
@@ -125,6 +126,7 @@ PyMODINIT_FUNC PyInit_capi(void) {
   REACTIONS_PYTHON_CLASS_READY(ElementPDGType);
   REACTIONS_PYTHON_CLASS_READY(ReactionType);
   REACTIONS_PYTHON_CLASS_READY(DecayType);
+  REACTIONS_PYTHON_CLASS_READY(DecayTreePDGType);
   REACTIONS_PYTHON_CLASS_READY(DatabasePDGType);
   REACTIONS_PYTHON_CLASS_READY(DatabaseNuBaseType);
   REACTIONS_PYTHON_CLASS_READY(SystemOfUnitsPDGType);
@@ -142,6 +144,7 @@ PyMODINIT_FUNC PyInit_capi(void) {
   REACTIONS_PYTHON_REGISTER_CLASS(m, "string_element", ElementStringType);
   REACTIONS_PYTHON_REGISTER_CLASS(m, "reaction", ReactionType);
   REACTIONS_PYTHON_REGISTER_CLASS(m, "decay", DecayType);
+  REACTIONS_PYTHON_REGISTER_CLASS(m, "decay_tree", DecayTreePDGType);
   REACTIONS_PYTHON_REGISTER_CLASS(m, "pdg_database_sgl", DatabasePDGType);
   REACTIONS_PYTHON_REGISTER_CLASS(m, "nubase_database_sgl", DatabaseNuBaseType);
   REACTIONS_PYTHON_REGISTER_CLASS(m, "pdg_system_of_units_sgl",
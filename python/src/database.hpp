@@ -1,5 +1,9 @@
 #pragma once
+#include <cmath>
+#include <cstring>
+#include <string>
 #include <utility>
+#include <vector>
 
 #define PY_SSIZE_T_CLEAN
 #include "Python.h"
@@ -182,6 +186,204 @@ static PyObject *DatabasePDG_charge_conjugate(DatabasePDG *self,
       self->instance->charge_conjugate(((ElementPDG *)obj)->element));
 }
 
+// Resolve a batch of elements and fill columnar buffers with their properties
+static PyObject *DatabasePDG_bulk_properties(DatabasePDG *self, PyObject *args,
+                                             PyObject *kwargs) {
+
+  static const char *kwds[] = {"elements", "masses", "widths", "charges",
+                               NULL};
+
+  PyObject *elements_obj = NULL, *masses_obj = Py_None, *widths_obj = Py_None,
+           *charges_obj = Py_None;
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|OOO",
+                                   const_cast<char **>(kwds), &elements_obj,
+                                   &masses_obj, &widths_obj, &charges_obj))
+    return NULL;
+
+  // check that a buffer holds items of one of the given formats (an
+  // optional native byte-order prefix is accepted)
+  auto check_format = [](Py_buffer const &buffer, char const *allowed) {
+    char const *fmt = buffer.format ? buffer.format : "B";
+    if (*fmt == '@' || *fmt == '=')
+      ++fmt;
+    return fmt[0] != '\0' && fmt[1] == '\0' &&
+           std::strchr(allowed, fmt[0]) != nullptr;
+  };
+
+  // the input is either a contiguous buffer of integer IDs (like a NumPy
+  // array) or a sequence of names
+  std::vector<int> ids;
+  std::vector<std::string> names;
+
+  Py_buffer ids_buffer;
+  if (PyObject_GetBuffer(elements_obj, &ids_buffer,
+                         PyBUF_CONTIG_RO | PyBUF_FORMAT) == 0) {
+
+    auto count = static_cast<std::size_t>(
+        ids_buffer.itemsize ? ids_buffer.len / ids_buffer.itemsize : 0);
+
+    ids.reserve(count);
+
+    // the item type must be a signed integer; a buffer of the right
+    // size but another type (like floating-point IDs) would otherwise
+    // be reinterpreted as garbage integers
+    if (!check_format(ids_buffer, "ilqn")) {
+      PyBuffer_Release(&ids_buffer);
+      PyErr_SetString(PyExc_TypeError,
+                      "The buffer of IDs must contain signed 32- or 64-bit "
+                      "integers ('i', 'l', 'q' or 'n' items)");
+      return NULL;
+    }
+
+    if (ids_buffer.itemsize == sizeof(int)) {
+      auto const *data = static_cast<int const *>(ids_buffer.buf);
+      ids.assign(data, data + count);
+    } else if (ids_buffer.itemsize == sizeof(long long)) {
+      auto const *data = static_cast<long long const *>(ids_buffer.buf);
+      for (std::size_t i = 0; i < count; ++i)
+        ids.emplace_back(static_cast<int>(data[i]));
+    } else {
+      PyBuffer_Release(&ids_buffer);
+      PyErr_SetString(PyExc_TypeError,
+                      "The buffer of IDs must contain 32- or 64-bit integers");
+      return NULL;
+    }
+
+    PyBuffer_Release(&ids_buffer);
+
+  } else {
+
+    PyErr_Clear();
+
+    if (PyUnicode_Check(elements_obj)) {
+      PyErr_SetString(PyExc_TypeError,
+                      "The first argument must be a buffer of IDs or a "
+                      "sequence of names, not a single string");
+      return NULL;
+    }
+
+    PyObject *seq =
+        PySequence_Fast(elements_obj, "The first argument must be a buffer "
+                                      "of IDs or a sequence of names");
+    if (!seq)
+      return NULL;
+
+    auto count = static_cast<std::size_t>(PySequence_Fast_GET_SIZE(seq));
+
+    names.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+      if (!PyUnicode_Check(item)) {
+        Py_DECREF(seq);
+        PyErr_SetString(PyExc_TypeError,
+                        "The sequence of names must contain strings");
+        return NULL;
+      }
+      auto const *str = PyUnicode_AsUTF8(item);
+      if (!str) {
+        Py_DECREF(seq);
+        return NULL;
+      }
+      names.emplace_back(str);
+    }
+
+    Py_DECREF(seq);
+  }
+
+  auto count = ids.empty() ? names.size() : ids.size();
+
+  // acquire the optional output buffers, which must be contiguous and
+  // writable, with one double per input element
+  struct column {
+    Py_buffer buffer;
+    double *data = nullptr;
+  } mass_col, width_col, charge_col;
+
+  auto acquire = [count, &check_format](PyObject *obj, column &col) -> bool {
+    if (obj == Py_None)
+      return true;
+
+    if (PyObject_GetBuffer(obj, &col.buffer, PyBUF_CONTIG | PyBUF_FORMAT) != 0)
+      return false;
+
+    if (!check_format(col.buffer, "d") ||
+        col.buffer.itemsize != sizeof(double) ||
+        static_cast<std::size_t>(col.buffer.len) != count * sizeof(double)) {
+      PyBuffer_Release(&col.buffer);
+      PyErr_SetString(PyExc_ValueError,
+                      "Output buffers must be contiguous, writable and "
+                      "contain one double ('d' item) per input element");
+      return false;
+    }
+
+    col.data = static_cast<double *>(col.buffer.buf);
+    return true;
+  };
+
+  auto release = [](column &col) -> void {
+    if (col.data)
+      PyBuffer_Release(&col.buffer);
+  };
+
+  if (!acquire(masses_obj, mass_col))
+    return NULL;
+  if (!acquire(widths_obj, width_col)) {
+    release(mass_col);
+    return NULL;
+  }
+  if (!acquire(charges_obj, charge_col)) {
+    release(mass_col);
+    release(width_col);
+    return NULL;
+  }
+
+  // resolve the whole batch and fill the columns with the GIL released
+  std::string error;
+  PyObject *error_type = NULL;
+
+  Py_BEGIN_ALLOW_THREADS;
+  try {
+
+    auto elements = ids.empty() ? self->instance->bulk(names)
+                                : self->instance->bulk(ids);
+
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+      if (mass_col.data)
+        mass_col.data[i] =
+            elements[i].has_mass() ? elements[i].mass() : std::nan("");
+      if (width_col.data)
+        width_col.data[i] =
+            elements[i].has_width() ? elements[i].width() : std::nan("");
+      if (charge_col.data)
+        charge_col.data[i] = elements[i].charge();
+    }
+
+  } catch (reactions::lookup_error &e) {
+    error = e.what();
+    error_type = LookupError;
+  } catch (reactions::database_error &e) {
+    error = e.what();
+    error_type = DatabaseError;
+  } catch (...) {
+    error = "Unexpected behaviour (internal error); please report the bug";
+    error_type = InternalError;
+  }
+  Py_END_ALLOW_THREADS;
+
+  release(mass_col);
+  release(width_col);
+  release(charge_col);
+
+  if (error_type) {
+    PyErr_SetString(error_type, error.c_str());
+    return NULL;
+  }
+
+  Py_RETURN_NONE;
+}
+
 using DatabasePDG_accessors =
     database_accessors<DatabasePDG, ElementPDG, &ElementPDGType>;
 
@@ -217,6 +419,33 @@ Returns
 -------
 list(pdg_element)
     All the elements
+)"},
+    {"bulk_properties", (PyCFunction)DatabasePDG_bulk_properties,
+     METH_VARARGS | METH_KEYWORDS,
+     R"(bulk_properties(elements, masses=None, widths=None, charges=None)
+
+Resolve a whole batch of elements in a single call and fill the given
+columnar buffers with their properties, releasing the GIL while the
+batch is processed.
+
+Parameters
+----------
+elements : buffer or sequence of str
+    Contiguous buffer of 32- or 64-bit integer PDG IDs (like a NumPy
+    array) or sequence of element names
+masses : buffer, optional
+    Contiguous writable buffer of doubles, filled with the masses
+    (NaN when not defined)
+widths : buffer, optional
+    Contiguous writable buffer of doubles, filled with the widths
+    (NaN when not defined)
+charges : buffer, optional
+    Contiguous writable buffer of doubles, filled with the charges
+
+Raises
+------
+LookupError
+    If any of the elements is not found
 )"},
     {"clear_cache", (PyCFunction)DatabasePDG_accessors::clear_cache,
      METH_NOARGS,
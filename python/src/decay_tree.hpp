@@ -0,0 +1,281 @@
+#pragma once
+
+#define PY_SSIZE_T_CLEAN
+#include "Python.h"
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "reactions/processes.hpp"
+
+#include "errors.hpp"
+
+/*! Handle-based view of a decay of PDG elements.
+
+  Unlike the \ref Decay class, which recursively copies the whole C++
+  tree into per-node Python wrapper objects, this object holds a shared
+  reference to a single C++-owned tree (built once and moved, never
+  copied) together with its flattened preorder entries, and the fields
+  of any node are read through thin accessors taking the entry index.
+  Constructing and inspecting large chains therefore does not scale
+  with the size of the tree in allocations, and subtrees are extracted
+  as new handles sharing the same underlying tree.
+*/
+typedef struct {
+  PyObject_HEAD
+  /// Shared C++-owned tree; several handles may point to the same tree
+  std::shared_ptr<reactions::decay<reactions::pdg_element> const> tree;
+  /// Flattened preorder entries, pointing into the shared tree
+  std::vector<reactions::flat_process<reactions::pdg_element>::entry> entries;
+} DecayTreePDG;
+
+// Allocate a new DecayTreePDG, building the non-trivial members in-place
+static PyObject *DecayTreePDG_new(PyTypeObject *type, PyObject *Py_UNUSED(args),
+                                  PyObject *Py_UNUSED(kwargs)) {
+
+  DecayTreePDG *self = (DecayTreePDG *)type->tp_alloc(type, 0);
+
+  if (!self)
+    return NULL;
+
+  new (&self->tree)
+      std::shared_ptr<reactions::decay<reactions::pdg_element> const>{};
+  new (&self->entries) std::vector<
+      reactions::flat_process<reactions::pdg_element>::entry>{};
+
+  return (PyObject *)self;
+}
+
+// Destroy the non-trivial members and free the object
+static void DecayTreePDG_dealloc(DecayTreePDG *self) {
+  self->tree
+      .~shared_ptr<reactions::decay<reactions::pdg_element> const>();
+  self->entries.~vector();
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+/// Initialize the tree parsing the given decay string
+static int DecayTreePDG_init(DecayTreePDG *self, PyObject *args,
+                             PyObject *kwargs) {
+
+  const char *str = nullptr;
+
+  if (kwargs != NULL)
+    REACTIONS_PYTHON_RETURN_INVALID_ARGUMENTS(-1);
+
+  if (!PyArg_ParseTuple(args, "s", &str))
+    return -1;
+
+  try {
+
+    // the tree is built once and moved to its final (stable) location
+    auto tree =
+        std::make_shared<reactions::decay<reactions::pdg_element> const>(
+            reactions::make_decay<reactions::pdg_element>(str));
+
+    reactions::flat_process<reactions::pdg_element> flat{*tree};
+
+    self->tree = std::move(tree);
+    self->entries.assign(flat.begin(), flat.end());
+  }
+  REACTIONS_PYTHON_CATCH_ERRORS(-1);
+
+  return 0;
+}
+
+// Check the index of an entry, setting an error if it is out of bounds
+static bool DecayTreePDG_check_index(DecayTreePDG *self, Py_ssize_t i) {
+  if (i < 0 || static_cast<std::size_t>(i) >= self->entries.size()) {
+    PyErr_SetString(PyExc_IndexError, "Entry index out of range");
+    return false;
+  }
+  return true;
+}
+
+// Parse the single entry-index argument of the accessors
+static bool DecayTreePDG_parse_index(DecayTreePDG *self, PyObject *args,
+                                     Py_ssize_t &i) {
+  if (!PyArg_ParseTuple(args, "n", &i))
+    return false;
+  return DecayTreePDG_check_index(self, i);
+}
+
+/// Number of entries of the flattened tree
+static Py_ssize_t DecayTreePDG_length(DecayTreePDG *self) {
+  return static_cast<Py_ssize_t>(self->entries.size());
+}
+
+/// Type of the entry, as a string
+static PyObject *DecayTreePDG_node_type(DecayTreePDG *self, PyObject *args) {
+
+  Py_ssize_t i;
+  if (!DecayTreePDG_parse_index(self, args, i))
+    return NULL;
+
+  return PyUnicode_FromString(
+      reactions::processes::node_type_properties::to_c_string(
+          self->entries[i].type));
+}
+
+/// Name of the element (or of the head, for nested decays)
+static PyObject *DecayTreePDG_name(DecayTreePDG *self, PyObject *args) {
+
+  Py_ssize_t i;
+  if (!DecayTreePDG_parse_index(self, args, i))
+    return NULL;
+
+  return PyUnicode_FromString(self->entries[i].element->name().c_str());
+}
+
+/// PDG ID of the element (or of the head, for nested decays)
+static PyObject *DecayTreePDG_pdg_id(DecayTreePDG *self, PyObject *args) {
+
+  Py_ssize_t i;
+  if (!DecayTreePDG_parse_index(self, args, i))
+    return NULL;
+
+  return PyLong_FromLong(self->entries[i].element->pdg_id());
+}
+
+/// Mass of the element (or of the head), or None if it is not defined
+static PyObject *DecayTreePDG_mass(DecayTreePDG *self, PyObject *args) {
+
+  Py_ssize_t i;
+  if (!DecayTreePDG_parse_index(self, args, i))
+    return NULL;
+
+  if (!self->entries[i].element->has_mass())
+    Py_RETURN_NONE;
+
+  return PyFloat_FromDouble(self->entries[i].element->mass());
+}
+
+/// Charge of the element (or of the head, for nested decays)
+static PyObject *DecayTreePDG_charge(DecayTreePDG *self, PyObject *args) {
+
+  Py_ssize_t i;
+  if (!DecayTreePDG_parse_index(self, args, i))
+    return NULL;
+
+  return PyFloat_FromDouble(self->entries[i].element->charge());
+}
+
+/// Total number of entries of the subtree starting at the given entry
+static PyObject *DecayTreePDG_subtree_size(DecayTreePDG *self, PyObject *args) {
+
+  Py_ssize_t i;
+  if (!DecayTreePDG_parse_index(self, args, i))
+    return NULL;
+
+  return PyLong_FromSize_t(self->entries[i].size);
+}
+
+/// New handle to the subtree starting at the given entry, sharing the tree
+static PyObject *DecayTreePDG_subtree(DecayTreePDG *self, PyObject *args) {
+
+  Py_ssize_t i;
+  if (!DecayTreePDG_parse_index(self, args, i))
+    return NULL;
+
+  DecayTreePDG *sub =
+      (DecayTreePDG *)DecayTreePDG_new(Py_TYPE(self), NULL, NULL);
+
+  if (!sub)
+    return NULL;
+
+  try {
+    sub->tree = self->tree; // share the C++-owned tree
+    sub->entries.assign(self->entries.begin() + i,
+                        self->entries.begin() + i + self->entries[i].size);
+  }
+  REACTIONS_PYTHON_CATCH_ERRORS(NULL, Py_DECREF(sub));
+
+  return (PyObject *)sub;
+}
+
+// Methods of the DecayTreePDG class
+static PyMethodDef DecayTreePDG_methods[] = {
+    {"node_type", (PyCFunction)DecayTreePDG_node_type, METH_VARARGS,
+     "Type of the entry at the given index ('element' or 'decay')"},
+    {"name", (PyCFunction)DecayTreePDG_name, METH_VARARGS,
+     "Name of the element at the given index (the head, for nested decays)"},
+    {"pdg_id", (PyCFunction)DecayTreePDG_pdg_id, METH_VARARGS,
+     "PDG ID of the element at the given index (the head, for nested decays)"},
+    {"mass", (PyCFunction)DecayTreePDG_mass, METH_VARARGS,
+     "Mass of the element at the given index, or None if it is not defined"},
+    {"charge", (PyCFunction)DecayTreePDG_charge, METH_VARARGS,
+     "Charge of the element at the given index"},
+    {"subtree_size", (PyCFunction)DecayTreePDG_subtree_size, METH_VARARGS,
+     "Number of entries of the subtree starting at the given index"},
+    {"subtree", (PyCFunction)DecayTreePDG_subtree, METH_VARARGS,
+     R"(New handle to the subtree starting at the given index.
+
+The returned object shares the underlying C++-owned tree; no copy of
+the nodes is made.)"},
+    {NULL, NULL, 0, NULL}};
+
+// Sequence protocol (only the length is exposed)
+static PySequenceMethods DecayTreePDG_sequence = {
+    (lenfunc)DecayTreePDG_length, /* sq_length */
+    0,                            /* sq_concat */
+    0,                            /* sq_repeat */
+    0,                            /* sq_item */
+    0,                            /* was_sq_slice */
+    0,                            /* sq_ass_item */
+    0,                            /* was_sq_ass_slice */
+    0,                            /* sq_contains */
+    0,                            /* sq_inplace_concat */
+    0,                            /* sq_inplace_repeat */
+};
+
+// Definition of the DecayTreePDG type
+static PyTypeObject DecayTreePDGType = {
+    PyVarObject_HEAD_INIT(NULL, 0) "reactions.decay_tree", /* tp_name */
+    sizeof(DecayTreePDG),                     /* tp_basicsize */
+    0,                                        /* tp_itemsize */
+    (destructor)DecayTreePDG_dealloc,         /* tp_dealloc */
+    0,                                        /* tp_vectorcall_offset */
+    0,                                        /* tp_getattr */
+    0,                                        /* tp_setattr */
+    0,                                        /* tp_as_async */
+    0,                                        /* tp_repr */
+    0,                                        /* tp_as_number */
+    &DecayTreePDG_sequence,                   /* tp_as_sequence */
+    0,                                        /* tp_as_mapping */
+    0,                                        /* tp_hash */
+    0,                                        /* tp_call */
+    0,                                        /* tp_str */
+    0,                                        /* tp_getattro */
+    0,                                        /* tp_setattro */
+    0,                                        /* tp_as_buffer */
+    Py_TPFLAGS_DEFAULT,                       /* tp_flags */
+    R"(decay_tree(string)
+
+Handle to a decay of PDG elements owned by the C++ side.
+
+The decay string is parsed once into a single C++-owned tree, and the
+Python object only holds a shared reference to it together with the
+flattened preorder entries; the fields of any node are read through
+accessors taking the entry index, with no per-node Python wrapper
+objects. Entry zero is the whole decay, whose element accessors refer
+to the head.)",                               /* tp_doc */
+    0,                                        /* tp_traverse */
+    0,                                        /* tp_clear */
+    0,                                        /* tp_richcompare */
+    0,                                        /* tp_weaklistoffset */
+    0,                                        /* tp_iter */
+    0,                                        /* tp_iternext */
+    DecayTreePDG_methods,                     /* tp_methods */
+    0,                                        /* tp_members */
+    0,                                        /* tp_getset */
+    0,                                        /* tp_base */
+    0,                                        /* tp_dict */
+    0,                                        /* tp_descr_get */
+    0,                                        /* tp_descr_set */
+    0,                                        /* tp_dictoffset */
+    (initproc)DecayTreePDG_init,              /* tp_init */
+    0,                                        /* tp_alloc */
+    DecayTreePDG_new,                         /* tp_new */
+};
@@ -0,0 +1,134 @@
+#include "reactions/all.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+#include <string>
+
+using namespace reactions;
+
+// Decay descriptors representative of shallow and deeply nested processes
+static const std::string shallow_decay = "pi+ -> mu+ nu(mu)";
+static const std::string nested_decay =
+    "B0 -> {D- -> {K(S)0 -> pi+ pi-} pi- pi0} pi+";
+static const std::string shallow_reaction = "p p~ -> pi+ pi-";
+
+// Access an element by name with the cache enabled
+static void pdg_access_by_name_cached(benchmark::State &state) {
+  auto &db = pdg_database::instance();
+  db.enable_cache();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(db("pi+"));
+}
+BENCHMARK(pdg_access_by_name_cached);
+
+// Access an element by PDG ID with the cache enabled
+static void pdg_access_by_id_cached(benchmark::State &state) {
+  auto &db = pdg_database::instance();
+  db.enable_cache();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(db(+211));
+}
+BENCHMARK(pdg_access_by_id_cached);
+
+// Access an element by name reading the database file
+static void pdg_access_by_name_uncached(benchmark::State &state) {
+  auto &db = pdg_database::instance();
+  db.disable_cache();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(db("pi+"));
+  db.enable_cache();
+}
+BENCHMARK(pdg_access_by_name_uncached);
+
+// Fill the cache from the database file
+static void pdg_enable_cache(benchmark::State &state) {
+  auto &db = pdg_database::instance();
+  for (auto _ : state) {
+    db.disable_cache();
+    db.enable_cache();
+  }
+}
+BENCHMARK(pdg_enable_cache);
+
+// Read the whole database without altering the cache
+static void pdg_all_elements(benchmark::State &state) {
+  auto &db = pdg_database::instance();
+  db.enable_cache();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(db.all_elements());
+}
+BENCHMARK(pdg_all_elements);
+
+// Parse a shallow decay resolving the elements in the PDG database
+static void make_decay_shallow(benchmark::State &state) {
+  pdg_database::instance().enable_cache();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(make_decay<pdg_element>(shallow_decay));
+}
+BENCHMARK(make_decay_shallow);
+
+// Parse a deeply nested decay resolving the elements in the PDG database
+static void make_decay_nested(benchmark::State &state) {
+  pdg_database::instance().enable_cache();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(make_decay<pdg_element>(nested_decay));
+}
+BENCHMARK(make_decay_nested);
+
+// Parse a shallow decay without any database access; the difference
+// with respect to make_decay_shallow isolates the element-resolution cost
+static void make_decay_string(benchmark::State &state) {
+  for (auto _ : state)
+    benchmark::DoNotOptimize(make_decay<string_element>(shallow_decay));
+}
+BENCHMARK(make_decay_string);
+
+// Parse a shallow reaction resolving the elements in the PDG database
+static void make_reaction_shallow(benchmark::State &state) {
+  pdg_database::instance().enable_cache();
+  for (auto _ : state)
+    benchmark::DoNotOptimize(make_reaction<pdg_element>(shallow_reaction));
+}
+BENCHMARK(make_reaction_shallow);
+
+// Compare two equal decays (the worst case, where all nodes are visited)
+static void decay_comparison_equal(benchmark::State &state) {
+  pdg_database::instance().enable_cache();
+  auto a = make_decay<pdg_element>(nested_decay);
+  auto b = make_decay<pdg_element>(nested_decay);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(a == b);
+}
+BENCHMARK(decay_comparison_equal);
+
+// Compare two different decays (short-circuited by the cached hashes)
+static void decay_comparison_different(benchmark::State &state) {
+  pdg_database::instance().enable_cache();
+  auto a = make_decay<pdg_element>(nested_decay);
+  auto b = make_decay<pdg_element>(shallow_decay);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(a == b);
+}
+BENCHMARK(decay_comparison_different);
+
+// Parse a stream of decay descriptors
+static void parse_decay_stream(benchmark::State &state) {
+  pdg_database::instance().enable_cache();
+
+  std::string data;
+  for (auto i = 0u; i < 1000u; ++i)
+    data += shallow_decay + '\n';
+
+  for (auto _ : state) {
+    std::istringstream in{data};
+    std::size_t count = parse_stream<decay<pdg_element>>(
+        in, [](decay<pdg_element> &&) -> void {});
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetItemsProcessed(state.iterations() * 1000);
+}
+BENCHMARK(parse_decay_stream);
+
+BENCHMARK_MAIN();
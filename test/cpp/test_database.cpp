@@ -2,6 +2,8 @@
 
 #include "reactions/all.hpp"
 
+#include <cstdio>
+
 using namespace reactions;
 
 int main() {
@@ -50,6 +52,251 @@ int main() {
 
     return errors;
   });
+  pdg_database_coll.add_test_function(
+      "test memory mapping", []() -> test::errors {
+        test::errors errors;
+
+        try {
+
+          auto &db = pdg_database::instance();
+
+          db.disable_cache();
+          db.enable_memory_mapping();
+
+          if (!db.uses_memory_mapping())
+            errors.push_back("Unable to enable the memory-mapped mode");
+
+          if (db("pi+").pdg_id() != db(+211).pdg_id())
+            errors.push_back("Accessors by string and PDG ID do not retrieve "
+                             "the same elements on a memory-mapped database");
+
+          auto mapped_size = db.all_elements().size();
+
+          db.disable_memory_mapping();
+
+          if (db.all_elements().size() != mapped_size)
+            errors.push_back("Memory-mapped and buffered reads provide a "
+                             "different number of elements");
+
+          db.enable_memory_mapping();
+          db.enable_cache(); // fill the cache from the memory-mapped file
+
+          if (db("pi+").pdg_id() != +211)
+            errors.push_back(
+                "Unable to fill the cache from a memory-mapped database");
+
+          db.disable_memory_mapping();
+        }
+        REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+        return errors;
+      });
+  pdg_database_coll.add_test_function(
+      "test parallel cache", []() -> test::errors {
+        test::errors errors;
+
+        try {
+
+          auto &db = pdg_database::instance();
+
+          db.disable_cache();
+          db.enable_cache();
+          auto sequential = db.all_elements();
+
+          db.disable_cache();
+          db.enable_cache(4);
+          auto parallel = db.all_elements();
+
+          if (sequential.size() != parallel.size())
+            errors.push_back("Sequential and parallel cache fills provide a "
+                             "different number of elements");
+          else
+            for (auto i = 0u; i < sequential.size(); ++i)
+              if (sequential[i] != parallel[i]) {
+                errors.push_back("Sequential and parallel cache fills provide "
+                                 "different elements");
+                break;
+              }
+
+          if (db("pi+").pdg_id() != +211)
+            errors.push_back("Unable to access a cache filled in parallel");
+        }
+        REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+        return errors;
+      });
+  pdg_database_coll.add_test_function(
+      "test compiled table", []() -> test::errors {
+        test::errors errors;
+
+        try {
+
+          auto &db = pdg_database::instance();
+
+          auto path = db.get_database_path();
+
+          db.enable_cache();
+          auto reference = db.all_elements();
+
+          auto compiled = std::string{"compiled_pdg_table.rbin"};
+
+          db.compile_to(compiled);
+
+          // pointing the database to a compiled table loads the cache
+          // directly from it
+          db.clear_cache();
+          db.set_database_path(compiled);
+
+          auto loaded = db.all_elements();
+
+          if (reference.size() != loaded.size())
+            errors.push_back("Wrong number of elements in a compiled table");
+          else
+            for (auto i = 0u; i < reference.size(); ++i)
+              if (reference[i] != loaded[i] ||
+                  reference[i].name() != loaded[i].name()) {
+                errors.push_back("Wrong contents in a compiled table");
+                break;
+              }
+
+          if (db("pi+").pdg_id() != +211)
+            errors.push_back("Unable to access a compiled table");
+
+          // restore the original state
+          db.clear_cache();
+          db.set_database_path(path);
+          db.enable_cache();
+
+          std::remove(compiled.c_str());
+        }
+        REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+        return errors;
+      });
+  pdg_database_coll.add_test_function(
+      "test elements view", []() -> test::errors {
+        test::errors errors;
+
+        try {
+
+          auto &db = pdg_database::instance();
+
+          db.disable_cache();
+
+          try {
+            db.all_elements_view();
+            errors.push_back("Should have thrown an error when requesting a "
+                             "view without the cache");
+          } catch (reactions::database_error &) {
+          };
+
+          db.enable_cache();
+
+          auto view = db.all_elements_view();
+          auto copies = db.all_elements();
+
+          if (static_cast<std::size_t>(view->end() - view->begin()) !=
+              copies.size())
+            errors.push_back("The view and the copies differ in size");
+
+          // the view is not invalidated by later modifications of the cache
+          db.disable_cache();
+
+          if (view->size() != copies.size() ||
+              view->begin()->name() != copies.front().name())
+            errors.push_back(
+                "The view should survive modifications of the cache");
+
+          db.enable_cache();
+        }
+        REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+        return errors;
+      });
+  pdg_database_coll.add_test_function("test columns", []() -> test::errors {
+    test::errors errors;
+
+    try {
+
+      auto &db = pdg_database::instance();
+
+      db.enable_cache();
+
+      auto masses = db.column<pdg::mass, reactions::fields::value>();
+      auto charges = db.column<pdg::three_charge>();
+      auto view = db.all_elements_view();
+
+      if (masses->size() != view->size() || charges->size() != view->size())
+        errors.push_back("Wrong size of the field columns");
+      else
+        for (auto i = 0u; i < view->size(); ++i) {
+          auto const &el = *(view->begin() + i);
+          if ((el.has_mass() && (*masses)[i] != el.mass()) ||
+              (!el.has_mass() && (*masses)[i] == (*masses)[i]) ||
+              (*charges)[i] != el.three_charge()) {
+            errors.push_back("Wrong contents of the field columns");
+            break;
+          }
+        }
+
+      // columns are shared until the cache changes
+      if (db.column<pdg::mass, reactions::fields::value>().get() !=
+          masses.get())
+        errors.push_back("Columns should be shared for the same cache state");
+
+      db.disable_cache();
+      db.enable_cache();
+
+      if (db.column<pdg::mass, reactions::fields::value>().get() ==
+          masses.get())
+        errors.push_back(
+            "Columns should be rebuilt when the cache is reloaded");
+
+      if (masses->size() == 0)
+        errors.push_back("Handed-out columns should remain valid");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+  pdg_database_coll.add_test_function("test bulk", []() -> test::errors {
+    test::errors errors;
+
+    try {
+
+      auto &db = pdg_database::instance();
+
+      auto check_bulk = [&errors, &db]() -> void {
+        auto by_name = db.bulk(std::vector<std::string>{"pi+", "K(S)0", "pi+"});
+        auto by_id = db.bulk(std::vector<int>{+211, 310, +211});
+
+        if (by_name.size() != 3 || by_id.size() != 3)
+          errors.push_back("Bulk lookups do not preserve the batch size");
+        else
+          for (auto i = 0u; i < by_name.size(); ++i)
+            if (by_name[i] != by_id[i]) {
+              errors.push_back("Bulk lookups by name and ID do not retrieve "
+                               "the same elements");
+              break;
+            }
+
+        try {
+          db.bulk(std::vector<std::string>{"pi+", "not-a-particle"});
+          errors.push_back("Should have thrown an error on a bulk lookup "
+                           "with a missing element");
+        } catch (reactions::lookup_error &) {
+        };
+      };
+
+      db.disable_cache();
+      check_bulk();
+      db.enable_cache();
+      check_bulk();
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
   pdg_database_coll.add_test_function(
       "test user elements", []() -> test::errors {
         test::errors errors;
@@ -140,6 +387,22 @@ int main() {
         if ((diff > 0 ? diff : -diff) > 1e-12)
           errors.push_back("Wrong unit scale factors");
 
+        // the scale factor is a constant expression
+        static_assert(reactions::units::reference<
+                          reactions::energy_units,
+                          reactions::energy_units::GeV>::scale_factor(
+                          reactions::energy_units::MeV) == 1e3);
+
+        // accesses with compile-time units ignore the system of units
+        sou.set_energy_units(reactions::GeV);
+
+        auto z0_mev =
+            db("Z0").get_as<reactions::MeV, pdg::mass, fields::value>();
+
+        auto diff_ct = z0_mass_gev - z0_mev * 1e-3;
+        if ((diff_ct > 0 ? diff_ct : -diff_ct) > 1e-12)
+          errors.push_back("Wrong compile-time unit scale factors");
+
         return errors;
       });
 
@@ -188,6 +451,40 @@ int main() {
 
     return errors;
   });
+  nubase_database_coll.add_test_function("test lru cache", []() -> test::errors {
+    test::errors errors;
+
+    try {
+
+      auto &db = nubase_database::instance();
+
+      db.disable_cache();
+      db.enable_lru_cache(2);
+
+      if (db("1H").nubase_id() != db(1001000).nubase_id())
+        errors.push_back("Accessors by string and NuBase ID do not retrieve "
+                         "the same elements with the bounded cache");
+
+      // "1H" and "1n" fit; looking up a third element evicts the least
+      // recently used one, which must still be resolvable from the file
+      db("1n");
+      db("3H");
+      db("1H");
+
+      if (db("1n").name() != "1n" || db("3H").name() != "3H" ||
+          db("1H").name() != "1H")
+        errors.push_back("Wrong lookups through the bounded cache");
+
+      db.disable_lru_cache();
+
+      if (db("1H").nubase_id() != 1001000)
+        errors.push_back("Unable to look up elements after disabling the "
+                         "bounded cache");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
   nubase_database_coll.add_test_function(
       "test user elements", []() -> test::errors {
         test::errors errors;
@@ -299,6 +596,53 @@ int main() {
         return errors;
       });
 
+  /*
+    Tests for the composite database
+  */
+  test::collector composite_coll("composite_database");
+  composite_coll.add_test_function("test composite", []() -> test::errors {
+    test::errors errors;
+
+    try {
+
+      auto &db = composite_database::instance();
+
+      db.enable_cache(true); // warm both caches concurrently
+
+      auto pion = db("pi+");
+      auto proton = db(1001000);
+
+      if (!std::holds_alternative<pdg_element>(pion) ||
+          !std::holds_alternative<nubase_element>(proton))
+        errors.push_back("Wrong resolution of mixed elements");
+
+      if (std::get<pdg_element>(pion).pdg_id() != +211 ||
+          std::get<nubase_element>(proton).name() != "1H")
+        errors.push_back("Wrong contents of mixed elements");
+
+      try {
+        db("not-anywhere");
+        errors.push_back("Should have thrown an error on an unknown name");
+      } catch (reactions::lookup_error &) {
+      };
+
+      // elements of both databases can appear in the same decay
+      auto d = make_decay<mixed_element>("1n -> 1H e- nu(e)~");
+
+      if (d.products().size() != 3 ||
+          !std::holds_alternative<nubase_element>(d.head()) ||
+          !std::holds_alternative<pdg_element>(
+              d.products().at(1).as_element()))
+        errors.push_back("Unable to parse a decay with mixed elements");
+
+      if (d != make_decay<mixed_element>("1n -> e- 1H nu(e)~"))
+        errors.push_back("Mixed decays should compare as usual");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
   /*
     Run the tests
    */
@@ -306,6 +650,8 @@ int main() {
   auto pdg_sou_status = !pdg_system_of_units_coll.run();
   auto nubase_status = !nubase_database_coll.run();
   auto nubase_sou_status = !nubase_system_of_units_coll.run();
+  auto composite_status = !composite_coll.run();
 
-  return pdg_status || pdg_sou_status || nubase_status || nubase_sou_status;
+  return pdg_status || pdg_sou_status || nubase_status || nubase_sou_status ||
+         composite_status;
 }
@@ -2,6 +2,9 @@
 
 #include "reactions/all.hpp"
 
+#include <sstream>
+#include <unordered_set>
+
 using namespace reactions;
 
 template <class Element> struct reaction_tester {
@@ -86,8 +89,420 @@ int main() {
   REACTIONS_TEST_UTILS_ADD_TEST(decay_coll,
                                 decay_tester<nubase_element>{"1n -> 1H e-"});
 
+  // Test the construction of processes in an arena
+  test::collector arena_coll("arena tests");
+  arena_coll.add_test_function("test arena", []() -> test::errors {
+    test::errors errors;
+    try {
+      arena ar;
+
+      auto r = make_reaction_in<string_element>(
+          ar, "A B -> {C -> D E} {F G -> H I}");
+
+      if (r.reactants().size() != 2 || r.products().size() != 2)
+        errors.push_back("Wrong number of nodes in an arena-built reaction");
+
+      auto d = make_decay_in<pdg_element>(
+          ar, "K(S)0 -> {pi+ -> mu+ nu(mu)} pi-");
+
+      if (d.products().size() != 2)
+        errors.push_back("Wrong number of nodes in an arena-built decay");
+
+      if (d != make_decay<pdg_element>("K(S)0 -> {pi+ -> mu+ nu(mu)} pi-"))
+        errors.push_back(
+            "Arena-built and heap-built decays should compare equal");
+
+      // copies are not tied to the arena
+      auto copy = d;
+      if (copy != d)
+        errors.push_back("Unable to copy an arena-built decay");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the hashing and comparison of processes
+  test::collector hash_coll("hash tests");
+  hash_coll.add_test_function("test hash", []() -> test::errors {
+    test::errors errors;
+    try {
+      auto d1 = make_decay<pdg_element>("K(S)0 -> pi+ pi-");
+      auto d2 = make_decay<pdg_element>("K(S)0 -> pi- pi+"); // permutation
+      auto d3 = make_decay<pdg_element>("K(S)0 -> mu+ mu-");
+
+      if (d1.hash() != d2.hash() || d1 != d2)
+        errors.push_back(
+            "Permutations of the products should provide the same process");
+
+      if (d1.hash() == d3.hash() || d1 == d3)
+        errors.push_back("Different decays should not compare equal");
+
+      auto r1 = make_reaction<string_element>("A B -> {C -> D E} F");
+      auto r2 = make_reaction<string_element>("B A -> F {C -> E D}");
+      auto r3 = make_reaction<string_element>("A B -> {C -> D E} G");
+
+      if (r1.hash() != r2.hash() || r1 != r2)
+        errors.push_back(
+            "Permutations of the nodes should provide the same process");
+
+      if (r1.hash() == r3.hash() || r1 == r3)
+        errors.push_back("Different reactions should not compare equal");
+
+      // processes can be used as keys of unordered containers
+      std::unordered_set<decay<pdg_element>> set;
+      set.emplace(make_decay<pdg_element>("K(S)0 -> pi+ pi-"));
+      set.emplace(make_decay<pdg_element>("K(S)0 -> pi- pi+"));
+      set.emplace(make_decay<pdg_element>("K(S)0 -> mu+ mu-"));
+
+      if (set.size() != 2)
+        errors.push_back("Unable to deduplicate decays in an unordered set");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test processes built on interned elements
+  test::collector interned_coll("interned tests");
+  interned_coll.add_test_function("test interned", []() -> test::errors {
+    test::errors errors;
+    try {
+      using handle = interned_element<pdg_element>;
+
+      auto d1 = make_decay<handle>("K(S)0 -> pi+ pi-");
+      auto d2 = make_decay<handle>("K(S)0 -> pi+ pi-");
+
+      if (d1 != d2)
+        errors.push_back("Interned decays should compare equal");
+
+      // all the uses of an element share a single copy
+      if (&*d1.head() != &*d2.head())
+        errors.push_back(
+            "Interned elements should point to a single database copy");
+
+      if (d1.head()->pdg_id() != 310)
+        errors.push_back("Unable to access an interned element");
+
+      if (d1 == make_decay<handle>("K(S)0 -> mu+ mu-"))
+        errors.push_back("Different interned decays should not be equal");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the non-throwing parse interface
+  test::collector try_coll("try-parse tests");
+  try_coll.add_test_function("test try parse", []() -> test::errors {
+    test::errors errors;
+    try {
+      auto good = try_make_decay<pdg_element>("K(S)0 -> pi+ pi-");
+
+      if (!good)
+        errors.push_back("A valid decay should parse successfully");
+      else if (good.value() != make_decay<pdg_element>("K(S)0 -> pi+ pi-"))
+        errors.push_back(
+            "Throwing and non-throwing parses should provide equal decays");
+
+      auto bad_syntax = try_make_decay<string_element>("A -> -> B");
+
+      if (bad_syntax)
+        errors.push_back("An invalid decay should not parse successfully");
+      else if (bad_syntax.error().kind != processes::parse_error::syntax ||
+               bad_syntax.error().position == std::string::npos)
+        errors.push_back("Wrong error description for a syntax failure");
+
+      auto bad_lookup = try_make_decay<pdg_element>("nothing -> pi+ pi-");
+
+      if (bad_lookup)
+        errors.push_back("An unknown element should not parse successfully");
+      else if (bad_lookup.error().kind != processes::parse_error::lookup)
+        errors.push_back("Wrong error description for a lookup failure");
+
+      auto bad_reaction = try_make_reaction<string_element>("A -> B}");
+
+      if (bad_reaction)
+        errors.push_back("Mismatching braces should not parse successfully");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the two-phase (syntax first, elements later) parse mode
+  test::collector resolve_coll("resolve tests");
+  resolve_coll.add_test_function("test resolve", []() -> test::errors {
+    test::errors errors;
+    try {
+      // syntax-only parse: structure is validated with no database access
+      auto skeleton =
+          make_decay<string_element>("K(S)0 -> {pi+ -> mu+ nu(mu)} pi-");
+
+      auto resolved = resolve_decay<pdg_element>(skeleton);
+
+      if (resolved !=
+          make_decay<pdg_element>("K(S)0 -> {pi+ -> mu+ nu(mu)} pi-"))
+        errors.push_back(
+            "Resolving a skeleton should match the direct parse");
+
+      auto r = resolve_reaction<pdg_element>(
+          make_reaction<string_element>("p p~ -> {K(S)0 -> pi+ pi-} pi0"));
+
+      if (r != make_reaction<pdg_element>("p p~ -> {K(S)0 -> pi+ pi-} pi0"))
+        errors.push_back(
+            "Resolving a reaction skeleton should match the direct parse");
+
+      // unknown elements are reported when resolving, not when validating
+      auto bad = make_decay<string_element>("not-a-particle -> A B");
+
+      try {
+        resolve_decay<pdg_element>(bad);
+        errors.push_back("Should have thrown an error when resolving an "
+                         "unknown element");
+      } catch (reactions::lookup_error &) {
+      };
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the conservation kernels
+  test::collector kernel_coll("kernel tests");
+  kernel_coll.add_test_function("test conservation", []() -> test::errors {
+    test::errors errors;
+    try {
+      auto good = make_decay<pdg_element>("K(S)0 -> pi+ pi-");
+      auto bad = make_decay<pdg_element>("K(S)0 -> pi+ pi+");
+      auto nested_bad = make_decay<pdg_element>("B0 -> {D- -> pi- pi-} pi+");
+
+      if (!is_charge_conserving(good) || is_charge_conserving(bad) ||
+          is_charge_conserving(nested_bad))
+        errors.push_back("Wrong charge-conservation check for decays");
+
+      if (!is_charge_conserving(make_reaction<pdg_element>("p p~ -> pi+ pi-")) ||
+          is_charge_conserving(make_reaction<pdg_element>("p p -> pi+ pi-")))
+        errors.push_back("Wrong charge-conservation check for reactions");
+
+      auto q = mass_excess(good);
+
+      auto &db = pdg_database::instance();
+      auto expected =
+          db("K(S)0").mass() - db("pi+").mass() - db("pi-").mass();
+
+      if (q < 0 || (q - expected > 1e-12) || (expected - q > 1e-12))
+        errors.push_back("Wrong mass excess of a decay");
+
+      std::vector<decay<pdg_element>> decays;
+      decays.emplace_back(good);
+      decays.emplace_back(bad);
+
+      auto conserving = is_charge_conserving(decays);
+      auto excesses = mass_excess(decays);
+
+      if (conserving.size() != 2 || !conserving[0] || conserving[1] ||
+          excesses.size() != 2 || excesses[0] != q)
+        errors.push_back("Wrong bulk conservation checks");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the deduplication and matching of process collections
+  test::collector dedup_coll("dedup tests");
+  dedup_coll.add_test_function("test unique and match", []() -> test::errors {
+    test::errors errors;
+    try {
+      std::vector<decay<pdg_element>> decays;
+      decays.emplace_back(make_decay<pdg_element>("K(S)0 -> pi+ pi-"));
+      decays.emplace_back(make_decay<pdg_element>("pi+ -> mu+ nu(mu)"));
+      decays.emplace_back(make_decay<pdg_element>("K(S)0 -> pi- pi+")); // dup
+      decays.emplace_back(make_decay<pdg_element>("K(S)0 -> mu+ mu-"));
+      decays.emplace_back(make_decay<pdg_element>("pi+ -> mu+ nu(mu)")); // dup
+
+      auto uniq = reactions::unique(std::move(decays), 2);
+
+      if (uniq.size() != 3 ||
+          uniq[0] != make_decay<pdg_element>("K(S)0 -> pi+ pi-") ||
+          uniq[1] != make_decay<pdg_element>("pi+ -> mu+ nu(mu)") ||
+          uniq[2] != make_decay<pdg_element>("K(S)0 -> mu+ mu-"))
+        errors.push_back("Wrong deduplication of a collection of decays");
+
+      std::vector<decay<pdg_element>> others;
+      others.emplace_back(make_decay<pdg_element>("phi(1020) -> K+ K-"));
+      others.emplace_back(make_decay<pdg_element>("pi+ -> mu+ nu(mu)"));
+
+      auto matches = reactions::match(uniq, others, 2);
+
+      if (matches.size() != 3 || matches[0] != reactions::no_match ||
+          matches[1] != 1 || matches[2] != reactions::no_match)
+        errors.push_back("Wrong matching of two collections of decays");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the flattened representation of processes
+  test::collector flat_coll("flat tests");
+  flat_coll.add_test_function("test flat process", []() -> test::errors {
+    test::errors errors;
+    try {
+      auto d = make_decay<string_element>("A -> {B -> C D} E");
+
+      flat_process<string_element> flat{d};
+
+      // preorder: A, {B -> C D}, C, D, E
+      if (flat.size() != 5)
+        errors.push_back("Wrong number of entries in a flattened decay");
+      else {
+        if (flat[0].type != processes::node_type::decay ||
+            *flat[0].element != "A" || flat[0].size != 5)
+          errors.push_back("Wrong root entry in a flattened decay");
+
+        if (*flat[1].element != "B" || flat[1].size != 3)
+          errors.push_back("Wrong nested entry in a flattened decay");
+
+        // skipping the nested decay subtree must land on "E"
+        if (!flat[1 + flat[1].size].is_element() ||
+            *flat[1 + flat[1].size].element != "E")
+          errors.push_back("Wrong subtree sizes in a flattened decay");
+      }
+
+      // count the elements with an iterative traversal
+      std::size_t count = 0;
+      flat.visit([&count](flat_process<string_element>::entry const &e) {
+        if (e.is_element())
+          ++count;
+      });
+
+      if (count != 3)
+        errors.push_back("Wrong number of elements in a flattened decay");
+
+      auto r = make_reaction<string_element>("A B -> C {D -> E F}");
+
+      flat_process<string_element> flat_r{r};
+
+      // preorder: <reaction>, A, B, C, <nested reaction>, D, E, F
+      if (flat_r.size() != 8 || flat_r[0].boundary != 2 ||
+          flat_r[4].type != processes::node_type::reaction ||
+          flat_r[4].size != 4 || flat_r[4].boundary != 1)
+        errors.push_back("Wrong layout of a flattened reaction");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the memoizing process registry
+  test::collector registry_coll("registry tests");
+  registry_coll.add_test_function("test registry", []() -> test::errors {
+    test::errors errors;
+    try {
+      decay_registry<pdg_element> registry;
+
+      auto first = registry("K(S)0 -> pi+ pi-");
+      auto second = registry("K(S)0 -> pi+ pi-");
+
+      if (first.get() != second.get())
+        errors.push_back("The registry should serve a shared process");
+
+      if (*first != make_decay<pdg_element>("K(S)0 -> pi+ pi-"))
+        errors.push_back("The memoized process is wrong");
+
+      registry("pi+ -> mu+ nu(mu)");
+
+      if (registry.size() != 2)
+        errors.push_back("Wrong number of memoized processes");
+
+      // errors do not poison the registry
+      try {
+        registry("K(S)0 -> ->");
+        errors.push_back("Should have thrown an error on an invalid decay");
+      } catch (reactions::syntax_error &) {
+      };
+
+      if (registry.size() != 2)
+        errors.push_back("A failed parse should not be registered");
+
+      registry.clear();
+
+      if (registry.size() != 0)
+        errors.push_back("Unable to clear the registry");
+
+      // memoized processes survive the registry
+      if (first->head().name() != "K(S)0")
+        errors.push_back("Memoized processes should survive a registry clear");
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
+  // Test the parsing of streams of processes
+  test::collector stream_coll("stream tests");
+  stream_coll.add_test_function("test parse stream", []() -> test::errors {
+    test::errors errors;
+    try {
+      std::string data;
+      for (auto i = 0u; i < 1000u; ++i)
+        data += (i % 2 ? "K(S)0 -> pi+ pi-\n" : "pi+ -> mu+ nu(mu)\n\n");
+
+      auto parse = [&data, &errors](unsigned concurrency) -> void {
+        std::istringstream in{data};
+
+        std::vector<decay<pdg_element>> out;
+        out.reserve(1000);
+
+        auto count = parse_stream<decay<pdg_element>>(
+            in,
+            [&out](decay<pdg_element> &&d) -> void {
+              out.emplace_back(std::move(d));
+            },
+            concurrency);
+
+        if (count != 1000u || out.size() != 1000u)
+          errors.push_back("Wrong number of processes parsed from a stream");
+        else if (out.front() != make_decay<pdg_element>("pi+ -> mu+ nu(mu)") ||
+                 out.back() != make_decay<pdg_element>("K(S)0 -> pi+ pi-"))
+          errors.push_back(
+              "Stream parsing does not preserve the order of the lines");
+      };
+
+      parse(1);
+      parse(4);
+
+      // errors are propagated also when parsing in parallel
+      try {
+        std::istringstream in{"pi+ -> mu+ nu(mu)\nA -> -> B\n"};
+        parse_stream<decay<string_element>>(
+            in, [](decay<string_element> &&) -> void {}, 4);
+        errors.push_back(
+            "Should have thrown an error when parsing an invalid stream");
+      } catch (reactions::syntax_error &) {
+      };
+    }
+    REACTIONS_TEST_UTILS_CATCH_EXCEPTIONS(errors);
+
+    return errors;
+  });
+
   auto reaction_status = !reaction_coll.run();
   auto decay_status = !decay_coll.run();
+  auto arena_status = !arena_coll.run();
+  auto hash_status = !hash_coll.run();
+  auto stream_status = !stream_coll.run();
+  auto interned_status = !interned_coll.run();
+  auto try_status = !try_coll.run();
+  auto registry_status = !registry_coll.run();
+  auto flat_status = !flat_coll.run();
+  auto dedup_status = !dedup_coll.run();
+  auto kernel_status = !kernel_coll.run();
+  auto resolve_status = !resolve_coll.run();
 
-  return reaction_status || decay_status;
+  return reaction_status || decay_status || arena_status || hash_status ||
+         stream_status || interned_status || try_status || registry_status ||
+         flat_status || dedup_status || kernel_status || resolve_status;
 }
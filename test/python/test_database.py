@@ -138,3 +138,48 @@ def test_pdg_charge_conjugate():
     for pa, cc in ('K(S)0', 'K(S)0'), ('pi+', 'pi-'), ('p', 'p~'), ('Lambda', 'Lambda~'):
         f, s = reactions.pdg_database(pa), reactions.pdg_database(cc)
         assert reactions.pdg_database.charge_conjugate(f) == s
+
+
+def test_pdg_bulk_properties():
+    import array
+    import math
+
+    db = reactions.pdg_database
+
+    db.enable_cache()
+
+    ids = array.array('q', [+211, 13, 23])
+    masses = array.array('d', [0.] * 3)
+    widths = array.array('d', [0.] * 3)
+    charges = array.array('d', [0.] * 3)
+
+    db.bulk_properties(ids, masses=masses, widths=widths, charges=charges)
+
+    for i, pid in enumerate(ids):
+        el = db(pid)
+        assert masses[i] == el.mass
+        assert widths[i] == el.width
+        assert charges[i] == el.charge
+
+    # the same values must be obtained accessing by name
+    by_name = array.array('d', [0.] * 3)
+    db.bulk_properties([db(pid).name for pid in ids], masses=by_name)
+    assert by_name == masses
+
+    # missing values are reported as NaN
+    out = array.array('d', [0.])
+    db.bulk_properties(['H0'], widths=out)
+    assert math.isnan(out[0])
+
+    with pytest.raises(reactions.LookupError):
+        db.bulk_properties(array.array('q', [999999911]))
+
+    with pytest.raises(ValueError):
+        db.bulk_properties(ids, masses=array.array('d', [0.]))
+
+    # buffers of the right size but the wrong item type are rejected
+    with pytest.raises(TypeError):
+        db.bulk_properties(array.array('d', [211., 13., 23.]))
+
+    with pytest.raises(ValueError):
+        db.bulk_properties(ids, masses=array.array('q', [0] * 3))
@@ -120,3 +120,27 @@ def test_syntax():
     reactions.reaction('A -> B {C D -> E} F')
     with pytest.raises(RuntimeError):
         reactions.decay('A -> B {C D -> E} F')
+
+
+def test_decay_tree():
+    tree = reactions.decay_tree('B0 -> {D- -> K+ pi- pi-} pi+')
+
+    # preorder: B0, D-, K+, pi-, pi-, pi+
+    assert len(tree) == 6
+    assert tree.node_type(0) == 'decay' and tree.name(0) == 'B0'
+    assert tree.node_type(1) == 'decay' and tree.subtree_size(1) == 4
+    assert tree.node_type(5) == 'element' and tree.name(5) == 'pi+'
+
+    assert tree.pdg_id(2) == reactions.pdg_database('K+').pdg_id
+    assert tree.mass(2) == reactions.pdg_database('K+').mass
+    assert tree.charge(3) == -1.
+
+    # subtrees are handles sharing the same underlying tree
+    sub = tree.subtree(1)
+    assert len(sub) == 4 and sub.name(0) == 'D-'
+
+    with pytest.raises(IndexError):
+        tree.name(len(tree))
+
+    with pytest.raises(reactions.SyntaxError):
+        reactions.decay_tree('pi+ -> ->')